@@ -0,0 +1,413 @@
+#ifndef IG_NOD_INCLUDE_NOD_INSTRUMENT_FLIGHT_RECORDER_HPP
+#define IG_NOD_INCLUDE_NOD_INSTRUMENT_FLIGHT_RECORDER_HPP
+
+// Recording of the most recent emissions of signals, see
+// nod::flight_recorder_policy.
+//
+// The flight recorder policy is opt-in, so it's declared in its own header
+// rather than in nod.hpp.
+
+#include "../nod.hpp"
+
+#include <algorithm>    // std::min()
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t
+#include <cstdio>       // std::FILE
+#include <map>          // std::map
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::mutex, std::lock_guard
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+namespace nod {
+	// implementational details
+	namespace detail {
+		/// Ring buffer of the most recent emissions on a thread.
+		///
+		/// The ring is written by the owning thread only, and new entries
+		/// overwrite the oldest ones. The ring can be read by any thread
+		/// without locking, while it is being written.
+		class flight_ring {
+			public:
+				/// Number of emissions held by a ring
+				static constexpr std::size_t capacity = 4096;
+
+				/// A emission as stored in the ring
+				struct entry {
+					std::uint32_t signal_id;
+					std::uint32_t slot_count;
+					std::int64_t timestamp;
+					std::int64_t duration;
+				};
+
+				/// Create a ring for a thread
+				/// @param thread_id   Identifier of the thread in dumps
+				explicit flight_ring( std::uint32_t thread_id ) :
+					_entries( new atomic_entry[capacity] ),
+					_begun( 0 ),
+					_written( 0 ),
+					_thread_id( thread_id )
+				{}
+
+				/// Record a emission. Only called by the thread owning the ring.
+				void push( entry const& e ) {
+					auto const index = _written.load( std::memory_order_relaxed );
+					// Announce the entry before overwriting the slot, so
+					// that readers can tell which entries they may have
+					// read while they were being overwritten.
+					_begun.store( index+1, std::memory_order_relaxed );
+					std::atomic_thread_fence( std::memory_order_release );
+					auto& slot = _entries[ index % capacity ];
+					slot.signal_id.store( e.signal_id, std::memory_order_relaxed );
+					slot.slot_count.store( e.slot_count, std::memory_order_relaxed );
+					slot.timestamp.store( e.timestamp, std::memory_order_relaxed );
+					slot.duration.store( e.duration, std::memory_order_relaxed );
+					_written.store( index+1, std::memory_order_release );
+				}
+
+				/// Copy the emissions held by the ring, oldest first.
+				/// @returns The emissions that were completely written.
+				std::vector<entry> snapshot() const {
+					auto const written = _written.load( std::memory_order_acquire );
+					auto first = written > capacity ? written - capacity : 0;
+					std::vector<entry> entries;
+					entries.reserve( written - first );
+					for( auto index = first; index != written; ++index ) {
+						auto const& slot = _entries[ index % capacity ];
+						entries.push_back( entry{
+							slot.signal_id.load( std::memory_order_relaxed ),
+							slot.slot_count.load( std::memory_order_relaxed ),
+							slot.timestamp.load( std::memory_order_relaxed ),
+							slot.duration.load( std::memory_order_relaxed ) } );
+					}
+					// Drop the entries that may have been overwritten while
+					// they were copied.
+					std::atomic_thread_fence( std::memory_order_acquire );
+					auto const begun = _begun.load( std::memory_order_relaxed );
+					if( begun > capacity && begun - capacity > first ) {
+						auto const overwritten = std::min( begun - capacity - first, entries.size() );
+						entries.erase( entries.begin(), entries.begin() + overwritten );
+					}
+					return entries;
+				}
+
+				/// @returns The identifier of the thread in dumps
+				std::uint32_t thread_id() const {
+					return _thread_id;
+				}
+
+				/// Empty the ring, to hand it over to a new thread. Only
+				/// called while no thread is writing to the ring.
+				/// @param thread_id   Identifier of the new thread in dumps
+				void reset( std::uint32_t thread_id ) {
+					_begun.store( 0, std::memory_order_relaxed );
+					_written.store( 0, std::memory_order_relaxed );
+					_thread_id = thread_id;
+				}
+
+			private:
+				struct atomic_entry {
+					std::atomic<std::uint32_t> signal_id;
+					std::atomic<std::uint32_t> slot_count;
+					std::atomic<std::int64_t> timestamp;
+					std::atomic<std::int64_t> duration;
+				};
+				std::unique_ptr<atomic_entry[]> _entries;
+				std::atomic<std::size_t> _begun;
+				std::atomic<std::size_t> _written;
+				std::uint32_t _thread_id;
+		};
+	} // namespace detail
+
+	/// Recorder of the most recent emissions of signals, for post-mortem
+	/// analysis of latency spikes and crashes.
+	///
+	/// Signals using `nod::flight_recorder_policy` record the signal id,
+	/// slot count, start time and duration of every emission into a
+	/// fixed size ring buffer of the emitting thread, holding the last
+	/// `detail::flight_ring::capacity` emissions. Recording is lock free and
+	/// never allocates, so it can be kept enabled in production.
+	///
+	/// The memory used by the recorder is bounded by the number of threads
+	/// alive at the same time and the number of living named signals. The
+	/// ring of a thread that exits is kept, with its last emissions, until
+	/// a new thread takes it over. The name of a signal is forgotten when
+	/// the signal is destroyed.
+	///
+	/// `dump()` writes the rings of all threads to a file, in the following
+	/// binary format, using the byte order of the host:
+	///
+	///     char[8]  magic "NODFLREC"
+	///     u32      format version (1)
+	///     i64      steady clock time of the dump, in nanoseconds
+	///     i64      system clock time of the dump, in nanoseconds
+	///     u32      number of named signals, followed for each by
+	///                u32 signal id, u32 name length, name characters
+	///     u32      number of threads, followed for each by
+	///                u32 thread id, u32 number of emissions, followed for each by
+	///                  u32 signal id, u32 slot count,
+	///                  i64 steady clock start time, i64 duration in nanoseconds
+	///
+	/// The `nod_flight_decode` tool prints a dump as text.
+	class flight_recorder
+	{
+		public:
+			/// Version of the dump format
+			static constexpr std::uint32_t format_version = 1;
+
+			/// @returns A new signal id
+			static std::uint32_t register_signal() {
+				return state().next_signal_id.fetch_add( 1, std::memory_order_relaxed );
+			}
+
+			/// Associate a name with a signal id, replacing any previous name.
+			static void name_signal( std::uint32_t signal_id, char const* name ) {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				s.names[signal_id] = name;
+			}
+
+			/// Forget the name of a signal id, when the signal is destroyed.
+			static void forget_signal( std::uint32_t signal_id ) {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				s.names.erase( signal_id );
+			}
+
+			/// Record a emission in the ring of the calling thread.
+			static void record( detail::flight_ring::entry const& e ) {
+				thread_ring().push( e );
+			}
+
+			/// Write the recorded emissions of all threads to a file.
+			/// @param path   Path of the file to write.
+			/// @returns `true` if the file was written.
+			static bool dump( char const* path ) {
+				std::FILE* file = std::fopen( path, "wb" );
+				if( !file ) {
+					return false;
+				}
+				bool written = dump( file );
+				return std::fclose( file ) == 0 && written;
+			}
+
+			/// Write the recorded emissions of all threads to a open file.
+			/// @param file   File to write to.
+			/// @returns `true` if the dump was written.
+			static bool dump( std::FILE* file ) {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				bool ok = std::fwrite( "NODFLREC", 1, 8, file ) == 8;
+				ok = ok && write( file, format_version );
+				ok = ok && write( file, static_cast<std::int64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() ) );
+				ok = ok && write( file, static_cast<std::int64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::system_clock::now().time_since_epoch() ).count() ) );
+				ok = ok && write( file, static_cast<std::uint32_t>( s.names.size() ) );
+				for( auto const& name : s.names ) {
+					ok = ok && write( file, name.first );
+					ok = ok && write( file, static_cast<std::uint32_t>( name.second.size() ) );
+					ok = ok && std::fwrite( name.second.data(), 1, name.second.size(), file ) == name.second.size();
+				}
+				ok = ok && write( file, static_cast<std::uint32_t>( s.rings.size() ) );
+				for( auto const& ring : s.rings ) {
+					auto entries = ring->snapshot();
+					ok = ok && write( file, ring->thread_id() );
+					ok = ok && write( file, static_cast<std::uint32_t>( entries.size() ) );
+					for( auto const& e : entries ) {
+						ok = ok && write( file, e.signal_id );
+						ok = ok && write( file, e.slot_count );
+						ok = ok && write( file, e.timestamp );
+						ok = ok && write( file, e.duration );
+					}
+				}
+				return std::fflush( file ) == 0 && ok;
+			}
+
+		private:
+			/// Global state of the recorder
+			struct global_state {
+				global_state() :
+					next_signal_id( 0 ),
+					next_thread_id( 0 )
+				{}
+				std::atomic<std::uint32_t> next_signal_id;
+				std::mutex mutex;
+				std::uint32_t next_thread_id;
+				std::vector<std::unique_ptr<detail::flight_ring>> rings;
+				/// Rings of exited threads, that new threads can take over
+				std::vector<detail::flight_ring*> free_rings;
+				std::map<std::uint32_t, std::string> names;
+			};
+
+			/// Owner of the ring of a thread, giving it back when the thread
+			/// exits.
+			struct ring_owner {
+				ring_owner() :
+					ring( register_thread() )
+				{}
+				~ring_owner() {
+					release_thread( *ring );
+				}
+				ring_owner( ring_owner const& ) = delete;
+				ring_owner& operator=( ring_owner const& ) = delete;
+				detail::flight_ring* ring;
+			};
+
+			/// The state is never destroyed, as threads may still exit and
+			/// give back their ring after static destruction.
+			static global_state& state() {
+				static global_state* s = new global_state;
+				return *s;
+			}
+
+			/// @returns The ring of the calling thread
+			static detail::flight_ring& thread_ring() {
+				static thread_local ring_owner owner;
+				return *owner.ring;
+			}
+
+			/// Take over the ring of a exited thread, or create a new ring,
+			/// for the calling thread.
+			static detail::flight_ring* register_thread() {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				if( !s.free_rings.empty() ) {
+					auto ring = s.free_rings.back();
+					s.free_rings.pop_back();
+					ring->reset( s.next_thread_id++ );
+					return ring;
+				}
+				s.rings.emplace_back( new detail::flight_ring( s.next_thread_id++ ) );
+				return s.rings.back().get();
+			}
+
+			/// Give back the ring of a exiting thread. The ring keeps its
+			/// emissions, as the last ones of a thread may be the
+			/// interesting ones, until a new thread takes it over.
+			static void release_thread( detail::flight_ring& ring ) {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				s.free_rings.push_back( &ring );
+			}
+
+			/// Write a integer to a file, in host byte order
+			template <class T>
+			static bool write( std::FILE* file, T value ) {
+				return std::fwrite( &value, sizeof(T), 1, file ) == 1;
+			}
+	};
+
+	/// Instrument recording emissions with `nod::flight_recorder`.
+	class flight_recorder_instrument
+	{
+		public:
+			/// Scope of a single emission, recorded when it ends.
+			class emission
+			{
+				public:
+					/// Begin a emission
+					explicit emission( flight_recorder_instrument& instrument ) :
+						_signal_id( instrument._signal_id ),
+						_slot_count( instrument._slot_count.load( std::memory_order_relaxed ) ),
+						_start( std::chrono::steady_clock::now() ),
+						_active( true )
+					{}
+
+					/// Move constructor
+					emission( emission&& other ) :
+						_signal_id( other._signal_id ),
+						_slot_count( other._slot_count ),
+						_start( other._start ),
+						_active( other._active )
+					{
+						other._active = false;
+					}
+
+					/// End the emission
+					~emission() {
+						if( _active ) {
+							auto const duration = std::chrono::steady_clock::now() - _start;
+							flight_recorder::record( detail::flight_ring::entry{
+								_signal_id,
+								_slot_count,
+								std::chrono::duration_cast<std::chrono::nanoseconds>( _start.time_since_epoch() ).count(),
+								std::chrono::duration_cast<std::chrono::nanoseconds>( duration ).count() } );
+						}
+					}
+
+					int slot_begin( std::size_t ) const {
+						return 0;
+					}
+
+					void slot_end( std::size_t, int ) const {
+					}
+
+				private:
+					std::uint32_t _signal_id;
+					std::uint32_t _slot_count;
+					std::chrono::steady_clock::time_point _start;
+					bool _active;
+			};
+
+			flight_recorder_instrument() :
+				_signal_id( flight_recorder::register_signal() ),
+				_slot_count( 0 ),
+				_named( false )
+			{}
+
+			~flight_recorder_instrument() {
+				if( _named ) {
+					flight_recorder::forget_signal( _signal_id );
+				}
+			}
+
+			flight_recorder_instrument( flight_recorder_instrument const& ) = delete;
+			flight_recorder_instrument& operator=( flight_recorder_instrument const& ) = delete;
+
+			/// @returns The id of the signal in dumps
+			std::uint32_t signal_id() const {
+				return _signal_id;
+			}
+
+			void set_name( char const* name ) {
+				flight_recorder::name_signal( _signal_id, name );
+				_named = true;
+			}
+
+			void on_connect( std::size_t, std::size_t slot_count, std::size_t ) {
+				_slot_count.store( static_cast<std::uint32_t>( slot_count ), std::memory_order_relaxed );
+			}
+
+			void on_disconnect( std::size_t, std::size_t slot_count, std::size_t ) {
+				_slot_count.store( static_cast<std::uint32_t>( slot_count ), std::memory_order_relaxed );
+			}
+
+		private:
+			std::uint32_t _signal_id;
+			/// Number of connected slots, kept here so that emissions don't
+			/// need the signal mutex to read it.
+			std::atomic<std::uint32_t> _slot_count;
+			bool _named;
+	};
+
+	/// Policy for recording the most recent emissions of signals.
+	///
+	/// This policy extends a thread policy with a instrument that records
+	/// every emission with `nod::flight_recorder`.
+	///
+	/// @code
+	/// nod::signal_type<nod::flight_recorder_policy<>, void(int)> signal{ "on_request" };
+	/// signal(42);
+	/// nod::flight_recorder::dump( "emissions.nodfr" );
+	/// @endcode
+	///
+	/// @tparam P   The thread policy to extend.
+	template <class P = multithread_policy>
+	struct flight_recorder_policy : P
+	{
+		using instrument_type = flight_recorder_instrument;
+	};
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_INSTRUMENT_FLIGHT_RECORDER_HPP
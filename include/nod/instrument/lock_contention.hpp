@@ -0,0 +1,170 @@
+#ifndef IG_NOD_INCLUDE_NOD_INSTRUMENT_LOCK_CONTENTION_HPP
+#define IG_NOD_INCLUDE_NOD_INSTRUMENT_LOCK_CONTENTION_HPP
+
+// Lock statistics of the signal mutex, see nod::lock_contention_policy.
+//
+// The lock contention policy is opt-in, so it's declared in its own header
+// rather than in nod.hpp.
+
+#include "../nod.hpp"
+
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <mutex>        // std::mutex
+
+namespace nod {
+	/// Lock statistics of a single kind of signal operation.
+	struct lock_operation_statistics
+	{
+		/// Number of times the signal mutex has been acquired
+		std::uint64_t acquisitions;
+		/// Number of acquisitions that had to wait for another thread
+		/// holding the mutex.
+		std::uint64_t contended;
+		/// Total time spent waiting to acquire the mutex
+		std::chrono::nanoseconds wait_time;
+		/// Longest time spent waiting to acquire the mutex
+		std::chrono::nanoseconds max_wait_time;
+		/// Total time the mutex has been held
+		std::chrono::nanoseconds hold_time;
+	};
+
+	/// Snapshot of the lock statistics of a signal mutex, by operation.
+	///
+	/// Instances are returned by the method `lock_stats()` of signals
+	/// using `nod::lock_contention_policy`.
+	struct lock_statistics
+	{
+		/// Statistics of each operation, indexed by `nod::lock_operation`
+		lock_operation_statistics operations[lock_operation_count];
+
+		/// @returns The statistics of a operation
+		lock_operation_statistics const& operator[]( lock_operation op ) const {
+			return operations[ static_cast<std::size_t>( op ) ];
+		}
+	};
+
+	/// Mutex recording lock statistics, wrapping the mutex of another
+	/// thread policy.
+	///
+	/// @tparam M   The wrapped mutex type, which must provide `lock()`,
+	///             `try_lock()` and `unlock()` like `std::mutex`.
+	template <class M>
+	class contention_mutex
+	{
+		public:
+			contention_mutex() = default;
+			contention_mutex( contention_mutex const& ) = delete;
+			contention_mutex& operator=( contention_mutex const& ) = delete;
+
+			/// @returns A snapshot of the lock statistics
+			lock_statistics stats() const {
+				lock_statistics result;
+				for( std::size_t i = 0; i < lock_operation_count; ++i ) {
+					auto const& counters = _counters[i];
+					result.operations[i] = lock_operation_statistics{
+						counters.acquisitions.load( std::memory_order_relaxed ),
+						counters.contended.load( std::memory_order_relaxed ),
+						std::chrono::nanoseconds{ counters.wait_ns.load( std::memory_order_relaxed ) },
+						std::chrono::nanoseconds{ counters.max_wait_ns.load( std::memory_order_relaxed ) },
+						std::chrono::nanoseconds{ counters.hold_ns.load( std::memory_order_relaxed ) } };
+				}
+				return result;
+			}
+
+		private:
+			template <class> friend class contention_lock;
+
+			/// Counters of a single operation
+			struct counters_type {
+				std::atomic<std::uint64_t> acquisitions{ 0 };
+				std::atomic<std::uint64_t> contended{ 0 };
+				std::atomic<std::int64_t> wait_ns{ 0 };
+				std::atomic<std::int64_t> max_wait_ns{ 0 };
+				std::atomic<std::int64_t> hold_ns{ 0 };
+			};
+
+			M _mutex;
+			counters_type _counters[lock_operation_count];
+	};
+
+	/// Scoped lock of a `nod::contention_mutex`, recording the wait and
+	/// hold times of the locking operation.
+	///
+	/// The clock is only read for waiting when the mutex is contended, so
+	/// uncontended acquisitions cost a `try_lock()` and two clock reads.
+	template <class M>
+	class contention_lock
+	{
+		public:
+			contention_lock( contention_mutex<M>& mutex, lock_operation operation ) :
+				_mutex( mutex ),
+				_counters( mutex._counters[ static_cast<std::size_t>( operation ) ] )
+			{
+				if( _mutex._mutex.try_lock() ) {
+					_acquired = std::chrono::steady_clock::now();
+				}
+				else {
+					auto const start = std::chrono::steady_clock::now();
+					_mutex._mutex.lock();
+					_acquired = std::chrono::steady_clock::now();
+					auto const wait = std::chrono::duration_cast<std::chrono::nanoseconds>( _acquired - start ).count();
+					_counters.contended.fetch_add( 1, std::memory_order_relaxed );
+					_counters.wait_ns.fetch_add( wait, std::memory_order_relaxed );
+					auto max = _counters.max_wait_ns.load( std::memory_order_relaxed );
+					while( wait > max && !_counters.max_wait_ns.compare_exchange_weak( max, wait, std::memory_order_relaxed ) ) {
+					}
+				}
+				_counters.acquisitions.fetch_add( 1, std::memory_order_relaxed );
+			}
+
+			/// Lock without telling the operation, counted as a query.
+			explicit contention_lock( contention_mutex<M>& mutex ) :
+				contention_lock( mutex, lock_operation::query )
+			{}
+
+			~contention_lock() {
+				auto const hold = std::chrono::steady_clock::now() - _acquired;
+				_counters.hold_ns.fetch_add( std::chrono::duration_cast<std::chrono::nanoseconds>( hold ).count(), std::memory_order_relaxed );
+				_mutex._mutex.unlock();
+			}
+
+			contention_lock( contention_lock const& ) = delete;
+			contention_lock& operator=( contention_lock const& ) = delete;
+
+		private:
+			contention_mutex<M>& _mutex;
+			typename contention_mutex<M>::counters_type& _counters;
+			std::chrono::steady_clock::time_point _acquired;
+	};
+
+	/// Policy for measuring the contention of signal mutexes.
+	///
+	/// This policy wraps the mutex of a thread policy, recording how many
+	/// times, how long and how often with contention the mutex of each
+	/// signal is acquired and held, split by `nod::lock_operation`. The
+	/// statistics are retrieved with the method `lock_stats()` of signals.
+	/// Since the policy is a drop in replacement, it can be swapped in with
+	/// a typedef to diagnose contention in production.
+	///
+	/// @code
+	/// template <class T>
+	/// using my_signal = nod::signal_type<nod::lock_contention_policy<>, T>;
+	/// my_signal<void(int)> signal;
+	/// // ...
+	/// auto emit = signal.lock_stats()[ nod::lock_operation::emit ];
+	/// @endcode
+	///
+	/// @tparam P   The thread policy to extend, with a mutex providing
+	///             `lock()`, `try_lock()` and `unlock()`.
+	template <class P = multithread_policy>
+	struct lock_contention_policy : P
+	{
+		using mutex_type = contention_mutex<typename P::mutex_type>;
+		using mutex_lock_type = contention_lock<typename P::mutex_type>;
+	};
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_INSTRUMENT_LOCK_CONTENTION_HPP
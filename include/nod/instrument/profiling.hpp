@@ -0,0 +1,266 @@
+#ifndef IG_NOD_INCLUDE_NOD_INSTRUMENT_PROFILING_HPP
+#define IG_NOD_INCLUDE_NOD_INSTRUMENT_PROFILING_HPP
+
+// Sampled timings of slot calls, see nod::profiling_policy.
+//
+// The profiling policy is opt-in, so it's declared in its own header
+// rather than in nod.hpp.
+
+#include "../nod.hpp"
+#include "thread_shard.hpp"
+
+#include <algorithm>    // std::min(), std::max()
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <mutex>        // std::mutex, std::lock_guard
+#include <string>       // std::string
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+namespace nod {
+	/// Sampled timing profile of a single slot.
+	///
+	/// Instances are part of the `nod::signal_profile` returned by the
+	/// method `profile()` of signals using `nod::profiling_policy`.
+	struct slot_profile
+	{
+		/// Number of buckets in the latency histogram.
+		static constexpr std::size_t histogram_size = 48;
+
+		/// The slot index of the slot.
+		std::size_t index;
+		/// Label given to the slot with `label_slot()`, if any.
+		std::string label;
+		/// Number of sampled calls of the slot.
+		std::uint64_t samples;
+		/// Total duration of the sampled calls.
+		std::chrono::nanoseconds total_time;
+		/// Longest duration of the sampled calls.
+		std::chrono::nanoseconds max_time;
+		/// Latency histogram of the sampled calls. Bucket `0` counts calls
+		/// taking less than 1ns, and bucket `i` counts calls taking from
+		/// `2^(i-1)`ns up to `2^i`ns.
+		std::uint64_t histogram[histogram_size];
+
+		/// @returns The mean duration of the sampled calls.
+		std::chrono::nanoseconds mean() const {
+			return samples == 0 ? std::chrono::nanoseconds{0} : total_time / static_cast<std::int64_t>( samples );
+		}
+
+		/// @param percentile   Percentile in the range [0, 100].
+		/// @returns            A upper bound of the duration at the given
+		///                     percentile of the sampled calls.
+		std::chrono::nanoseconds percentile( double percentile ) const {
+			auto target = static_cast<std::uint64_t>( percentile / 100.0 * samples + 0.5 );
+			target = target == 0 ? 1 : target;
+			std::uint64_t seen = 0;
+			for( std::size_t i = 0; i < histogram_size; ++i ) {
+				seen += histogram[i];
+				if( seen >= target ) {
+					return std::min( std::chrono::nanoseconds{ std::int64_t{1} << i }, max_time );
+				}
+			}
+			return max_time;
+		}
+	};
+
+	/// Report of the sampled slot timings of a signal.
+	struct signal_profile
+	{
+		/// One out of this many emissions of the signal is sampled.
+		std::size_t sample_rate;
+		/// Profiles of all slots that have been sampled or labeled, ordered
+		/// by slot index.
+		std::vector<slot_profile> slots;
+	};
+
+	/// Instrument recording sampled call durations of each slot.
+	///
+	/// One out of `SampleRate` emissions of the signal is sampled. The
+	/// slot calls of sampled emissions are timed, and recorded per slot
+	/// index. Recording takes a mutex owned by the instrument, which keeps
+	/// the overhead bounded by the sample rate.
+	///
+	/// Emissions are counted in per thread shards, like the counters of
+	/// `statistics_instrument`, so that threads triggering the same signal
+	/// don't contend on a single counter. Each shard samples one out of
+	/// `SampleRate` of the emissions counted in it.
+	///
+	/// @tparam SampleRate   Sample one out of this many emissions.
+	template <std::size_t SampleRate>
+	class profiling_instrument
+	{
+		public:
+			static_assert( SampleRate > 0, "The sample rate must be at least 1." );
+
+			/// Type of the profile report
+			using profile_type = signal_profile;
+			/// Type of the timings of a single slot
+			using slot_profile_type = slot_profile;
+			/// Type of the labels of slots
+			using label_type = std::string;
+
+			/// Scope of a single emission, deciding if the emission is sampled.
+			class emission
+			{
+				public:
+					using clock = std::chrono::steady_clock;
+
+					/// Begin a emission
+					explicit emission( profiling_instrument& instrument ) :
+						_instrument( &instrument ),
+						_sampled( instrument.sample() )
+					{}
+
+					/// @returns The start time of the slot call, or the epoch of
+					///          the clock if the emission isn't sampled.
+					clock::time_point slot_begin( std::size_t ) const {
+						return _sampled ? clock::now() : clock::time_point{};
+					}
+
+					void slot_end( std::size_t index, clock::time_point start ) const {
+						if( _sampled ) {
+							_instrument->record( index, clock::now() - start );
+						}
+					}
+
+				private:
+					profiling_instrument* _instrument;
+					bool _sampled;
+			};
+
+			profiling_instrument() {
+				for( auto& counters : _shards ) {
+					counters.emissions = 0;
+				}
+			}
+
+			void set_name( char const* ) {
+			}
+
+			void on_connect( std::size_t index, std::size_t, std::size_t ) {
+				std::lock_guard<std::mutex> lock{ _mutex };
+				if( index < _profiles.size() ) {
+					// A new slot is reusing the index
+					_profiles[index] = slot_profile{};
+					_profiles[index].index = index;
+				}
+			}
+
+			void on_disconnect( std::size_t, std::size_t, std::size_t ) {
+			}
+
+			/// Label a slot, to make it identifiable in the report
+			void label( std::size_t index, std::string label ) {
+				std::lock_guard<std::mutex> lock{ _mutex };
+				profile_at( index ).label = std::move( label );
+			}
+
+			/// @returns The profile of a single slot index
+			slot_profile profile( std::size_t index ) const {
+				std::lock_guard<std::mutex> lock{ _mutex };
+				if( index < _profiles.size() ) {
+					return _profiles[index];
+				}
+				slot_profile empty{};
+				empty.index = index;
+				return empty;
+			}
+
+			/// @returns The profile of all sampled or labeled slots
+			profile_type profile() const {
+				std::lock_guard<std::mutex> lock{ _mutex };
+				profile_type result;
+				result.sample_rate = SampleRate;
+				for( auto const& p : _profiles ) {
+					if( p.samples > 0 || !p.label.empty() ) {
+						result.slots.push_back( p );
+					}
+				}
+				return result;
+			}
+
+		private:
+			/// Number of emission counter shards
+			static constexpr std::size_t shard_count = 16;
+
+			/// Emission counter, padded to keep shards used by different
+			/// threads from sharing cache lines.
+			struct shard {
+				std::atomic<std::uint64_t> emissions;
+				char padding[128 - sizeof(std::atomic<std::uint64_t>)];
+			};
+
+			/// @returns `true` for one out of `SampleRate` emissions counted
+			///          in the shard of the calling thread.
+			bool sample() {
+				auto& own_shard = _shards[ detail::thread_shard_index() % shard_count ];
+				return own_shard.emissions.fetch_add( 1, std::memory_order_relaxed ) % SampleRate == 0;
+			}
+
+			/// Record the duration of a sampled slot call
+			void record( std::size_t index, std::chrono::steady_clock::duration duration ) {
+				auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>( duration );
+				std::size_t bucket = 0;
+				for( auto n = ns.count(); n > 0 && bucket+1 < slot_profile::histogram_size; n >>= 1 ) {
+					++bucket;
+				}
+				std::lock_guard<std::mutex> lock{ _mutex };
+				auto& p = profile_at( index );
+				++p.samples;
+				p.total_time += ns;
+				p.max_time = std::max( p.max_time, ns );
+				++p.histogram[bucket];
+			}
+
+			/// @returns The profile of a slot index, which is created if needed.
+			///          The mutex must be held when calling this.
+			slot_profile& profile_at( std::size_t index ) {
+				while( _profiles.size() <= index ) {
+					_profiles.push_back( slot_profile{} );
+					_profiles.back().index = _profiles.size() - 1;
+				}
+				return _profiles[index];
+			}
+
+			/// Mutex protecting the profiles
+			mutable std::mutex _mutex;
+			/// Profiles indexed by slot index
+			std::vector<slot_profile> _profiles;
+			/// Emission counter shards
+			shard _shards[shard_count];
+	};
+
+	/// Policy for profiling the slots of signals.
+	///
+	/// This policy extends a thread policy with a instrument that samples
+	/// one out of `SampleRate` emissions of each signal, and records the
+	/// duration of each slot call in the sampled emissions. This makes it
+	/// possible to find slots that make emissions slow.
+	///
+	/// The profile is retrieved with the `profile()` method of the signal,
+	/// and slots can be given labels with `label_slot()` to make them
+	/// identifiable in the profile.
+	///
+	/// @code
+	/// nod::signal_type<nod::profiling_policy<>, void(int)> signal;
+	/// auto connection = signal.connect( handler );
+	/// signal.label_slot( connection, "handler" );
+	/// ...
+	/// for( auto const& slot : signal.profile().slots ) {
+	///     std::cout << slot.label << ": " << slot.mean().count() << "ns\n";
+	/// }
+	/// @endcode
+	///
+	/// @tparam P            The thread policy to extend.
+	/// @tparam SampleRate   Sample one out of this many emissions.
+	template <class P = multithread_policy, std::size_t SampleRate = 64>
+	struct profiling_policy : P
+	{
+		using instrument_type = profiling_instrument<SampleRate>;
+	};
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_INSTRUMENT_PROFILING_HPP
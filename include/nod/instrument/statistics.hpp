@@ -0,0 +1,198 @@
+#ifndef IG_NOD_INCLUDE_NOD_INSTRUMENT_STATISTICS_HPP
+#define IG_NOD_INCLUDE_NOD_INSTRUMENT_STATISTICS_HPP
+
+// Runtime statistics of signals, see nod::statistics_policy.
+//
+// The statistics policy is opt-in, so it's declared in its own header
+// rather than in nod.hpp.
+
+#include "../nod.hpp"
+#include "thread_shard.hpp"
+
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+
+namespace nod {
+	/// Snapshot of the runtime statistics of a signal.
+	///
+	/// Instances are returned by the method `stats()` of signals using
+	/// `nod::statistics_policy`.
+	struct signal_statistics
+	{
+		/// Number of times the signal has been triggered.
+		std::uint64_t emissions;
+		/// Total number of slot calls made by the signal.
+		std::uint64_t slots_invoked;
+		/// Number of slots that have been connected.
+		std::uint64_t connects;
+		/// Number of slots that have been disconnected.
+		std::uint64_t disconnects;
+		/// Highest number of slots that have been connected at the same time.
+		std::size_t peak_slot_count;
+		/// Current number of empty slots left by disconnected slots, still
+		/// occupying the slot vector of the signal.
+		std::size_t tombstones;
+		/// Total time spent triggering the signal, including the slot calls.
+		std::chrono::nanoseconds emission_time;
+	};
+
+	/// Instrument recording runtime statistics of a signal.
+	///
+	/// The counters updated when triggering the signal are spread over
+	/// a number of shards, where each thread uses its own shard. This
+	/// way threads triggering the same signal don't contend on the same
+	/// counters.
+	///
+	/// @tparam Shards   Number of counter shards.
+	template <std::size_t Shards>
+	class statistics_instrument
+	{
+		public:
+			/// Type of the statistics snapshot
+			using statistics_type = signal_statistics;
+
+			/// Scope of a single emission, recording the emission and
+			/// the slot calls made.
+			class emission
+			{
+				public:
+					/// Begin a emission
+					explicit emission( statistics_instrument& instrument ) :
+						_instrument( &instrument ),
+						_start( std::chrono::steady_clock::now() )
+					{}
+
+					/// Move constructor
+					emission( emission&& other ) :
+						_instrument( other._instrument ),
+						_start( other._start )
+					{
+						other._instrument = nullptr;
+					}
+
+					/// End the emission, recording it along with its duration.
+					~emission() {
+						if( _instrument ) {
+							auto duration = std::chrono::steady_clock::now() - _start;
+							auto& own_shard = _instrument->current_shard();
+							own_shard.emissions.fetch_add( 1, std::memory_order_relaxed );
+							own_shard.emission_ns.fetch_add( static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( duration ).count() ), std::memory_order_relaxed );
+						}
+					}
+
+					int slot_begin( std::size_t ) const {
+						return 0;
+					}
+
+					void slot_end( std::size_t, int ) const {
+						_instrument->current_shard().slots_invoked.fetch_add( 1, std::memory_order_relaxed );
+					}
+
+				private:
+					statistics_instrument* _instrument;
+					std::chrono::steady_clock::time_point _start;
+			};
+
+			statistics_instrument() :
+				_connects( 0 ),
+				_disconnects( 0 ),
+				_peak_slot_count( 0 ),
+				_tombstones( 0 )
+			{
+				for( auto& counters : _shards ) {
+					counters.emissions = 0;
+					counters.slots_invoked = 0;
+					counters.emission_ns = 0;
+				}
+			}
+
+			void set_name( char const* ) {
+			}
+
+			void on_connect( std::size_t, std::size_t slot_count, std::size_t tombstones ) {
+				_connects.fetch_add( 1, std::memory_order_relaxed );
+				if( slot_count > _peak_slot_count.load( std::memory_order_relaxed ) ) {
+					_peak_slot_count.store( slot_count, std::memory_order_relaxed );
+				}
+				_tombstones.store( tombstones, std::memory_order_relaxed );
+			}
+
+			void on_disconnect( std::size_t disconnected, std::size_t, std::size_t tombstones ) {
+				_disconnects.fetch_add( disconnected, std::memory_order_relaxed );
+				_tombstones.store( tombstones, std::memory_order_relaxed );
+			}
+
+			/// @returns A snapshot of the recorded statistics. The counters are
+			///          read one by one, so the snapshot is not guaranteed to
+			///          be consistent while the signal is in use.
+			statistics_type stats() const {
+				statistics_type result{};
+				std::uint64_t emission_ns = 0;
+				for( auto const& counters : _shards ) {
+					result.emissions += counters.emissions.load( std::memory_order_relaxed );
+					result.slots_invoked += counters.slots_invoked.load( std::memory_order_relaxed );
+					emission_ns += counters.emission_ns.load( std::memory_order_relaxed );
+				}
+				result.connects = _connects.load( std::memory_order_relaxed );
+				result.disconnects = _disconnects.load( std::memory_order_relaxed );
+				result.peak_slot_count = _peak_slot_count.load( std::memory_order_relaxed );
+				result.tombstones = _tombstones.load( std::memory_order_relaxed );
+				result.emission_time = std::chrono::nanoseconds{ emission_ns };
+				return result;
+			}
+
+		private:
+			/// Counters updated when triggering the signal. The shard is
+			/// padded to keep shards used by different threads from
+			/// sharing cache lines.
+			struct shard {
+				std::atomic<std::uint64_t> emissions;
+				std::atomic<std::uint64_t> slots_invoked;
+				std::atomic<std::uint64_t> emission_ns;
+				char padding[128 - 3*sizeof(std::atomic<std::uint64_t>)];
+			};
+
+			/// @returns The shard used by the calling thread
+			shard& current_shard() {
+				return _shards[ detail::thread_shard_index() % Shards ];
+			}
+
+			/// Counter shards
+			shard _shards[Shards];
+			/// Number of connected slots, only updated while holding the signal mutex.
+			std::atomic<std::uint64_t> _connects;
+			/// Number of disconnected slots, only updated while holding the signal mutex.
+			std::atomic<std::uint64_t> _disconnects;
+			/// Highest slot count, only updated while holding the signal mutex.
+			std::atomic<std::size_t> _peak_slot_count;
+			/// Current number of tombstones, only updated while holding the signal mutex.
+			std::atomic<std::size_t> _tombstones;
+	};
+
+	/// Policy for collecting runtime statistics of signals.
+	///
+	/// This policy extends a thread policy with a instrument that records
+	/// the number of emissions, slot calls, connections and disconnections
+	/// of each signal, along with the time spent triggering the signal.
+	/// The statistics are retrieved with the `stats()` method of the signal.
+	///
+	/// @code
+	/// nod::signal_type<nod::statistics_policy<>, void(int)> signal;
+	/// signal(42);
+	/// auto emissions = signal.stats().emissions;
+	/// @endcode
+	///
+	/// @tparam P        The thread policy to extend.
+	/// @tparam Shards   Number of counter shards per signal. Threads
+	///                  triggering the same signal use separate shards, up
+	///                  to this number of threads.
+	template <class P = multithread_policy, std::size_t Shards = 16>
+	struct statistics_policy : P
+	{
+		using instrument_type = statistics_instrument<Shards>;
+	};
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_INSTRUMENT_STATISTICS_HPP
@@ -0,0 +1,22 @@
+#ifndef IG_NOD_INCLUDE_NOD_INSTRUMENT_THREAD_SHARD_HPP
+#define IG_NOD_INCLUDE_NOD_INSTRUMENT_THREAD_SHARD_HPP
+
+// Per thread sharding of counters, shared by the instruments.
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+
+namespace nod {
+	// implementational details
+	namespace detail {
+		/// @returns A small index unique to the calling thread, used to
+		///          spread per thread counters over several shards.
+		inline std::size_t thread_shard_index() {
+			static std::atomic<std::size_t> next{ 0 };
+			static thread_local std::size_t index = next.fetch_add( 1, std::memory_order_relaxed );
+			return index;
+		}
+	} // namespace detail
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_INSTRUMENT_THREAD_SHARD_HPP
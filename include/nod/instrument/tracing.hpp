@@ -0,0 +1,338 @@
+#ifndef IG_NOD_INCLUDE_NOD_INSTRUMENT_TRACING_HPP
+#define IG_NOD_INCLUDE_NOD_INSTRUMENT_TRACING_HPP
+
+// Tracing of emissions and slot calls in the Chrome trace event format,
+// see nod::tracing_policy.
+//
+// The tracing policy is opt-in, so it's declared in its own header
+// rather than in nod.hpp.
+
+#include "../nod.hpp"
+
+#include <algorithm>    // std::remove_if()
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::int64_t
+#include <cstdio>       // std::snprintf
+#include <memory>       // std::shared_ptr, std::unique_ptr
+#include <mutex>        // std::mutex, std::lock_guard
+#include <set>          // std::set
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+namespace nod {
+	// implementational details
+	namespace detail {
+		/// Event recorded by the tracer
+		struct trace_event {
+			/// Interned name of the signal
+			char const* name;
+			/// Time of the event, in nanoseconds since the clock epoch
+			std::int64_t timestamp;
+			/// Slot index for slot call events, or `emission` for
+			/// events of the emission itself.
+			std::size_t slot;
+			/// Event phase, 'B' for begin and 'E' for end.
+			char phase;
+
+			/// Slot index used for emission events
+			static constexpr std::size_t emission = static_cast<std::size_t>( -1 );
+		};
+		/// Lock free ring buffer of trace events, written by a single thread
+		/// and read by a single flushing thread at a time.
+		class trace_buffer {
+			public:
+				/// Maximum number of events held by a buffer
+				static constexpr std::size_t capacity = std::size_t{1} << 14;
+
+				/// Create a buffer for a thread
+				/// @param thread_id   Identifier of the thread in the trace
+				explicit trace_buffer( std::size_t thread_id ) :
+					_events( new trace_event[capacity] ),
+					_head( 0 ),
+					_tail( 0 ),
+					_dropped( 0 ),
+					_thread_id( thread_id )
+				{}
+
+				/// Add a event, which is dropped if the buffer is full.
+				/// Only called by the thread owning the buffer.
+				void push( trace_event const& event ) {
+					auto const head = _head.load( std::memory_order_relaxed );
+					if( head - _tail.load( std::memory_order_acquire ) == capacity ) {
+						_dropped.fetch_add( 1, std::memory_order_relaxed );
+						return;
+					}
+					_events[ head % capacity ] = event;
+					_head.store( head+1, std::memory_order_release );
+				}
+
+				/// Remove all events from the buffer, passing them to a function.
+				template <class F>
+				void drain( F&& func ) {
+					auto tail = _tail.load( std::memory_order_relaxed );
+					auto const head = _head.load( std::memory_order_acquire );
+					for( ; tail != head; ++tail ) {
+						func( _events[ tail % capacity ] );
+					}
+					_tail.store( tail, std::memory_order_release );
+				}
+
+				/// @returns The number of events dropped since the last call
+				std::size_t take_dropped() {
+					return _dropped.exchange( 0, std::memory_order_relaxed );
+				}
+
+				/// @returns The identifier of the thread in the trace
+				std::size_t thread_id() const {
+					return _thread_id;
+				}
+
+			private:
+				std::unique_ptr<trace_event[]> _events;
+				std::atomic<std::size_t> _head;
+				std::atomic<std::size_t> _tail;
+				std::atomic<std::size_t> _dropped;
+				std::size_t _thread_id;
+		};
+	} // namespace detail
+
+	/// Recorder of signal emissions and slot calls, in the Chrome trace
+	/// event format.
+	///
+	/// Signals using `nod::tracing_policy` record begin and end events of
+	/// every emission and slot call while the tracer is started. Each
+	/// thread records the events into its own lock free buffer, and the
+	/// buffers are emptied by `flush_chrome_json()`. The resulting JSON can
+	/// be loaded in `chrome://tracing` or Perfetto.
+	///
+	/// Each thread buffers up to `detail::trace_buffer::capacity` events
+	/// between flushes. Events recorded while the buffer is full are
+	/// dropped, and the number of dropped events is reported in the
+	/// metadata of the next flush.
+	class tracer
+	{
+		public:
+			/// Start recording events
+			static void start() {
+				state().enabled.store( true, std::memory_order_relaxed );
+			}
+
+			/// Stop recording events. Events already recorded are kept until
+			/// the next flush.
+			static void stop() {
+				state().enabled.store( false, std::memory_order_relaxed );
+			}
+
+			/// @returns `true` if events are being recorded
+			static bool enabled() {
+				return state().enabled.load( std::memory_order_relaxed );
+			}
+
+			/// Record a event on the buffer of the calling thread.
+			/// @param name    Interned name of the signal.
+			/// @param slot    Slot index, or `detail::trace_event::emission`.
+			/// @param phase   'B' for begin, and 'E' for end.
+			static void record( char const* name, std::size_t slot, char phase ) {
+				auto const now = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() );
+				thread_buffer().push( detail::trace_event{ name, now.count(), slot, phase } );
+			}
+
+			/// Intern a signal name, so that the name outlives the signal.
+			/// @returns A pointer to the interned name, which is valid for
+			///          the lifetime of the program.
+			static char const* intern( char const* name ) {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				return s.names.insert( name ).first->c_str();
+			}
+
+			/// Remove all recorded events from the thread buffers, and format
+			/// them as a Chrome trace event JSON document.
+			/// @returns The JSON document.
+			static std::string flush_chrome_json() {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				std::string json = "{\"traceEvents\":[";
+				bool first = true;
+				std::size_t dropped = 0;
+				char buffer[64];
+				for( auto const& thread_buffer : s.buffers ) {
+					dropped += thread_buffer->take_dropped();
+					thread_buffer->drain( [&]( detail::trace_event const& event ) {
+							json += first ? "\n" : ",\n";
+							first = false;
+							json += "{\"name\":\"";
+							if( event.slot != detail::trace_event::emission ) {
+								std::snprintf( buffer, sizeof(buffer), "slot %zu", event.slot );
+								json += buffer;
+							}
+							else {
+								append_escaped( json, event.name );
+							}
+							json += "\",\"cat\":\"";
+							json += event.slot != detail::trace_event::emission ? "nod.slot" : "nod.emission";
+							std::snprintf( buffer, sizeof(buffer), "\",\"ph\":\"%c\",\"ts\":%lld.%03d,\"pid\":1,\"tid\":%zu",
+								event.phase,
+								static_cast<long long>( event.timestamp / 1000 ),
+								static_cast<int>( event.timestamp % 1000 ),
+								thread_buffer->thread_id() );
+							json += buffer;
+							if( event.slot != detail::trace_event::emission ) {
+								json += ",\"args\":{\"signal\":\"";
+								append_escaped( json, event.name );
+								json += "\"}";
+							}
+							json += "}";
+						});
+				}
+				// Buffers of threads that have exited are no longer needed.
+				s.buffers.erase( std::remove_if( s.buffers.begin(), s.buffers.end(), []( std::shared_ptr<detail::trace_buffer> const& b ) {
+						return b.use_count() == 1;
+					}), s.buffers.end() );
+				std::snprintf( buffer, sizeof(buffer), "\n],\"metadata\":{\"dropped_events\":%zu}}\n", dropped );
+				json += buffer;
+				return json;
+			}
+
+		private:
+			/// Global state of the tracer
+			struct global_state {
+				global_state() :
+					enabled( false ),
+					next_thread_id( 0 )
+				{}
+				std::atomic<bool> enabled;
+				std::mutex mutex;
+				std::size_t next_thread_id;
+				std::vector<std::shared_ptr<detail::trace_buffer>> buffers;
+				std::set<std::string> names;
+			};
+
+			static global_state& state() {
+				static global_state s;
+				return s;
+			}
+
+			/// @returns The event buffer of the calling thread
+			static detail::trace_buffer& thread_buffer() {
+				static thread_local std::shared_ptr<detail::trace_buffer> buffer = register_thread();
+				return *buffer;
+			}
+
+			/// Create and register the event buffer of the calling thread
+			static std::shared_ptr<detail::trace_buffer> register_thread() {
+				auto& s = state();
+				std::lock_guard<std::mutex> lock{ s.mutex };
+				s.buffers.push_back( std::make_shared<detail::trace_buffer>( s.next_thread_id++ ) );
+				return s.buffers.back();
+			}
+
+			/// Append a string to a JSON document, escaping as needed
+			static void append_escaped( std::string& json, char const* str ) {
+				for( ; *str; ++str ) {
+					if( *str == '"' || *str == '\\' ) {
+						json += '\\';
+					}
+					if( static_cast<unsigned char>( *str ) >= 0x20 ) {
+						json += *str;
+					}
+				}
+			}
+	};
+
+	/// Instrument recording emissions and slot calls with `nod::tracer`.
+	class tracing_instrument
+	{
+		public:
+			/// Scope of a single emission, recording begin and end events
+			/// while the tracer is started.
+			class emission
+			{
+				public:
+					/// Begin a emission
+					explicit emission( tracing_instrument& instrument ) :
+						_name( instrument._name ),
+						_active( tracer::enabled() )
+					{
+						if( _active ) {
+							tracer::record( _name, detail::trace_event::emission, 'B' );
+						}
+					}
+
+					/// Move constructor
+					emission( emission&& other ) :
+						_name( other._name ),
+						_active( other._active )
+					{
+						other._active = false;
+					}
+
+					/// End the emission
+					~emission() {
+						if( _active ) {
+							tracer::record( _name, detail::trace_event::emission, 'E' );
+						}
+					}
+
+					bool slot_begin( std::size_t index ) const {
+						if( _active ) {
+							tracer::record( _name, index, 'B' );
+						}
+						return _active;
+					}
+
+					void slot_end( std::size_t index, bool active ) const {
+						if( active ) {
+							tracer::record( _name, index, 'E' );
+						}
+					}
+
+				private:
+					char const* _name;
+					bool _active;
+			};
+
+			tracing_instrument() :
+				_name( "nod::signal" )
+			{}
+
+			void set_name( char const* name ) {
+				_name = tracer::intern( name );
+			}
+
+			void on_connect( std::size_t, std::size_t, std::size_t ) {
+			}
+
+			void on_disconnect( std::size_t, std::size_t, std::size_t ) {
+			}
+
+		private:
+			/// Interned name of the signal
+			char const* _name;
+	};
+
+	/// Policy for tracing signals.
+	///
+	/// This policy extends a thread policy with a instrument that records
+	/// begin and end events of every emission and slot call with
+	/// `nod::tracer`, while the tracer is started. Signals should be given
+	/// names at construction to make the traces readable.
+	///
+	/// @code
+	/// nod::signal_type<nod::tracing_policy<>, void(int)> signal{ "on_request" };
+	/// nod::tracer::start();
+	/// signal(42);
+	/// std::ofstream{ "trace.json" } << nod::tracer::flush_chrome_json();
+	/// @endcode
+	///
+	/// @tparam P   The thread policy to extend.
+	template <class P = multithread_policy>
+	struct tracing_policy : P
+	{
+		using instrument_type = tracing_instrument;
+	};
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_INSTRUMENT_TRACING_HPP
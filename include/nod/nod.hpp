@@ -1,6 +1,8 @@
 #ifndef IG_NOD_INCLUDE_NOD_HPP
 #define IG_NOD_INCLUDE_NOD_HPP
 
+#include "nod_fwd.hpp"
+
 #include <vector>       // std::vector
 #include <functional>   // std::function
 #include <mutex>        // std::mutex, std::lock_guard
@@ -9,9 +11,73 @@
 #include <cassert>      // assert()
 #include <thread>       // std::this_thread::yield()
 #include <type_traits>  // std::is_same
-#include <iterator>     // std::back_inserter
+#include <iterator>     // std::back_inserter, std::begin(), std::end()
+#include <utility>      // std::declval
+#include <tuple>        // std::tuple
+#include <new>          // placement new
+#include <atomic>       // std::atomic
+#include <cstdint>      // std::uint64_t
+#include <cstddef>      // std::max_align_t
+
+// Static tracepoints (USDT) for tools like perf, bpftrace and SystemTap, in
+// the provider "nod". The probes are only compiled in when NOD_ENABLE_SDT is
+// defined, which requires <sys/sdt.h>. A probe with no tracer attached costs
+// a single nop instruction.
+#ifdef NOD_ENABLE_SDT
+#include <sys/sdt.h>
+#define NOD_PROBE1( name, a1 ) DTRACE_PROBE1( nod, name, a1 )
+#define NOD_PROBE2( name, a1, a2 ) DTRACE_PROBE2( nod, name, a1, a2 )
+#define NOD_PROBE3( name, a1, a2, a3 ) DTRACE_PROBE3( nod, name, a1, a2, a3 )
+#else
+// Without tracepoints the arguments are still evaluated as used, so their
+// parameters don't trigger unused parameter warnings.
+#define NOD_PROBE1( name, a1 ) ((void)(a1))
+#define NOD_PROBE2( name, a1, a2 ) ((void)(a1), (void)(a2))
+#define NOD_PROBE3( name, a1, a2, a3 ) ((void)(a1), (void)(a2), (void)(a3))
+#endif
+
+// ThreadSanitizer doesn't observe fences, so storage that is reused once it
+// is no longer shared, which is synchronized with a fence, is copied instead
+// when it's enabled.
+#if defined( __SANITIZE_THREAD__ )
+#define NOD_THREAD_SANITIZER 1
+#elif defined( __has_feature )
+#if __has_feature( thread_sanitizer )
+#define NOD_THREAD_SANITIZER 1
+#endif
+#endif
+
+// Signature independent code that is too large to be worth inlining is kept
+// out of line, so that it's shared by all signal types instead of being
+// inlined into each of them.
+#if defined( __GNUC__ )
+#define NOD_NOINLINE __attribute__(( noinline ))
+#elif defined( _MSC_VER )
+#define NOD_NOINLINE __declspec( noinline )
+#else
+#define NOD_NOINLINE
+#endif
 
 namespace nod {
+	/// Operations of a signal that lock the signal mutex.
+	///
+	/// Lock types of thread policies may be constructed with the
+	/// operation as a second argument, see `nod::lock_contention_policy`.
+	enum class lock_operation {
+		/// Taking a snapshot of the slots when the signal is triggered
+		emit,
+		/// Connecting a slot
+		connect,
+		/// Disconnecting a slot
+		disconnect,
+		/// Disconnecting all slots
+		disconnect_all,
+		/// Looking up a connection of the signal
+		query
+	};
+	/// Number of values of `nod::lock_operation`
+	static constexpr std::size_t lock_operation_count = 5;
+
 	// implementational details
 	namespace detail {
 		/// Interface for type erasure when disconnecting slots
@@ -21,11 +87,231 @@ namespace nod {
 		/// Deleter that doesn't delete
 		inline void no_delete(disconnector*){
 		};
+		/// Helper mapping any valid type to void, used for detecting
+		/// members and nested types of template parameters.
+		template <class>
+		struct void_type {
+			using type = void;
+		};
+		/// Trait telling if a type is an iterator (or a pointer), used to
+		/// tell output iterators and containers apart.
+		template <class T, class = void>
+		struct is_iterator : std::is_pointer<T> {};
+		template <class T>
+		struct is_iterator<T, typename void_type<typename T::iterator_category>::type> : std::true_type {};
+		/// Trait telling if a container can grow with `push_back`, or if
+		/// it has a fixed size like `std::array`.
+		template <class C, class = void>
+		struct is_back_insertable : std::false_type {};
+		template <class C>
+		struct is_back_insertable<C, typename void_type<decltype( std::declval<C&>().push_back( std::declval<typename C::value_type>() ) )>::type> : std::true_type {};
+		/// Reserve capacity in containers that support it.
+		template <class C>
+		auto reserve( C& container, std::size_t size, int ) -> decltype( container.reserve( size ), void() ) {
+			container.reserve( size );
+		}
+		/// Fallback for containers that don't support reserving capacity.
+		template <class C>
+		void reserve( C&, std::size_t, long ) {
+		}
+		/// Array type used to evaluate a expression for each element of a
+		/// parameter pack in order, as in `expand{ 0, ( f( x ), 0 )... }`.
+		using expand = int[];
+		/// Compile time sequence of indices, used for unpacking tuples.
+		template <std::size_t... I>
+		struct index_sequence {};
+		/// Generate a index_sequence with the indices `0..N-1`.
+		template <std::size_t N, std::size_t... I>
+		struct make_index_sequence : make_index_sequence<N-1, N-1, I...> {};
+		template <std::size_t... I>
+		struct make_index_sequence<0, I...> {
+			using type = index_sequence<I...>;
+		};
+		/// Storage for a value that is constructed on demand.
+		///
+		/// Similar to a optional value, this does not require the value
+		/// type to be `DefaultConstructible`.
+		template <class T>
+		class lazy_value {
+			public:
+				/// Create a instance without any value.
+				lazy_value() :
+					_constructed( false )
+				{}
+
+				lazy_value( lazy_value const& ) = delete;
+				lazy_value& operator=( lazy_value const& ) = delete;
+
+				/// Move constructor
+				/// @param other   The instance to move the value from.
+				lazy_value( lazy_value&& other ) :
+					_constructed( false )
+				{
+					if( other._constructed ) {
+						emplace( std::move( other.get() ) );
+					}
+				}
+
+				/// Destroy the value, if it has been constructed.
+				~lazy_value() {
+					if( _constructed ) {
+						get().~T();
+					}
+				}
+
+				/// @returns `true` if the value has been constructed.
+				bool has_value() const {
+					return _constructed;
+				}
+
+				/// Destroy the value, if it has been constructed.
+				void reset() {
+					if( _constructed ) {
+						get().~T();
+						_constructed = false;
+					}
+				}
+
+				/// Construct the value.
+				/// @param args   The arguments to construct the value from.
+				template <class... V>
+				void emplace( V&&... args ) {
+					assert( !_constructed );
+					new (&_storage) T( std::forward<V>(args)... );
+					_constructed = true;
+				}
+
+				/// @returns A reference to the constructed value.
+				T& get() {
+					assert( _constructed );
+					return *reinterpret_cast<T*>( &_storage );
+				}
+
+				/// @returns A reference to the constructed value.
+				T const& get() const {
+					assert( _constructed );
+					return *reinterpret_cast<T const*>( &_storage );
+				}
+
+			private:
+				/// Uninitialized storage for the value.
+				typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type _storage;
+				/// Flag telling if the value has been constructed.
+				bool _constructed;
+		};
+		/// Instrument that doesn't record anything.
+		///
+		/// This is the instrument used by signals with a thread policy that
+		/// doesn't provide a `instrument_type`. A instrument type must provide
+		/// the same members as this type. See `nod::statistics_policy` for a
+		/// policy providing a instrument.
+		struct no_instrument {
+			/// Scope of a single emission of a signal.
+			///
+			/// A emission is created before the slots are copied, and is
+			/// destroyed when the emission is done.
+			struct emission {
+				/// Begin a emission
+				explicit emission( no_instrument& ) {
+				}
+				/// Called before a slot is called. The returned token is
+				/// passed to `slot_end`. This may be called from several
+				/// threads at the same time, for the same emission.
+				int slot_begin( std::size_t ) const {
+					return 0;
+				}
+				/// Called after a slot has been called, or has thrown.
+				void slot_end( std::size_t, int ) const {
+				}
+			};
+			/// Called when the signal is constructed with a name.
+			/// @param name   The name of the signal.
+			void set_name( char const* /*name*/ ) {
+			}
+			/// Called when a slot has been connected, while holding the
+			/// signal mutex.
+			/// @param index        The slot index of the connected slot.
+			/// @param slot_count   Number of connected slots.
+			/// @param tombstones   Number of empty slots left by disconnected
+			///                     slots, still occupying the slot vector.
+			void on_connect( std::size_t /*index*/, std::size_t /*slot_count*/, std::size_t /*tombstones*/ ) {
+			}
+			/// Called when slots have been disconnected, while holding the
+			/// signal mutex.
+			/// @param disconnected   Number of disconnected slots.
+			/// @param slot_count     Number of connected slots.
+			/// @param tombstones     Number of empty slots left by disconnected
+			///                       slots, still occupying the slot vector.
+			void on_disconnect( std::size_t /*disconnected*/, std::size_t /*slot_count*/, std::size_t /*tombstones*/ ) {
+			}
+		};
+		/// Trait retrieving the instrument type of a thread policy, which
+		/// is `no_instrument` unless the policy has a `instrument_type`.
+		template <class P, class = void>
+		struct instrument_of {
+			using type = no_instrument;
+		};
+		template <class P>
+		struct instrument_of<P, typename void_type<typename P::instrument_type>::type> {
+			using type = typename P::instrument_type;
+		};
+		/// Trait retrieving the allocator of a thread policy, which is
+		/// `std::allocator` unless the policy has a `allocator_type`.
+		template <class P, class = void>
+		struct allocator_of {
+			using type = std::allocator<char>;
+		};
+		template <class P>
+		struct allocator_of<P, typename void_type<typename P::allocator_type>::type> {
+			using type = typename P::allocator_type;
+		};
+		/// The allocator of a thread policy, rebound to allocate `T` objects.
+		template <class P, class T>
+		using rebind_allocator = typename std::allocator_traits<typename allocator_of<P>::type>::template rebind_alloc<T>;
+		/// Scope of a single slot call within a emission.
+		template <class E>
+		class slot_scope {
+			public:
+				slot_scope( E& emission, std::size_t index ) :
+					_emission( emission ),
+					_index( index ),
+					_token( emission.slot_begin( index ) )
+				{}
+				~slot_scope() {
+					_emission.slot_end( _index, _token );
+				}
+				slot_scope( slot_scope const& ) = delete;
+				slot_scope& operator=( slot_scope const& ) = delete;
+			private:
+				E& _emission;
+				std::size_t _index;
+				decltype( std::declval<E&>().slot_begin( 0 ) ) _token;
+		};
+		/// Lock of a signal mutex, passing the locking operation on to the
+		/// lock type of the thread policy if it takes one.
+		template <class L, class M, bool = std::is_constructible<L, M&, lock_operation>::value>
+		class operation_lock {
+			public:
+				operation_lock( M& mutex, lock_operation operation ) :
+					_lock( mutex, operation )
+				{}
+			private:
+				L _lock;
+		};
+		template <class L, class M>
+		class operation_lock<L, M, false> {
+			public:
+				operation_lock( M& mutex, lock_operation ) :
+					_lock( mutex )
+				{}
+			private:
+				L _lock;
+		};
 	} // namespace detail
 
-	/// Base template for the signal class
-	template <class P, class T>
-	class signal_type;
+	namespace detail {
+		class signal_base;
+	} // namespace detail
 
 
 	/// Connection class.
@@ -80,6 +366,7 @@ namespace nod {
 			/// The signal template is a friend of the connection, since it is the
 			/// only one allowed to create instances using the meaningful constructor.
 			template<class P,class T> friend class signal_type;
+			friend class detail::signal_base;
 
 			/// Create a connection.
 			/// @param shared_disconnector   Disconnector instance that will be used to disconnect
@@ -222,227 +509,2487 @@ namespace nod {
 		}
 	};
 
-	/// Signal accumulator class template.
-	///
-	/// This acts sort of as a proxy for triggering a signal and
-	/// accumulating the slot return values.
+	namespace detail {
+		/// Cache of freed memory blocks, kept for each thread.
+		///
+		/// Blocks are grouped in size classes of powers of two, and a
+		/// limited number of freed blocks of each class is kept for reuse by
+		/// later allocations of the same thread. The cache of a thread is
+		/// only touched by that thread, so no synchronization is needed.
+		/// Blocks may be freed by a different thread than the one that
+		/// allocated them, and are then cached by the freeing thread.
+		class block_cache {
+			public:
+				/// Size of the blocks of the smallest size class
+				static constexpr std::size_t min_block_size = 64;
+				/// Number of size classes, the largest is 64 KiB
+				static constexpr std::size_t class_count = 11;
+				/// Maximum number of freed blocks cached for each size class
+				static constexpr std::size_t max_cached_blocks = 32;
+
+				/// Allocate a block of at least `size` bytes.
+				NOD_NOINLINE static void* allocate( std::size_t size ) {
+					std::size_t const c = size_class( size );
+					if( c == class_count ) {
+						return ::operator new( size );
+					}
+					lists& l = local();
+					if( l.heads[c] != nullptr ) {
+						block* b = l.heads[c];
+						l.heads[c] = b->next;
+						--l.counts[c];
+						return b;
+					}
+					return ::operator new( min_block_size << c );
+				}
+
+				/// Free a block allocated with `allocate`.
+				/// @param ptr    The block to free.
+				/// @param size   The size the block was allocated with.
+				NOD_NOINLINE static void deallocate( void* ptr, std::size_t size ) {
+					std::size_t const c = size_class( size );
+					if( c == class_count ) {
+						::operator delete( ptr );
+						return;
+					}
+					lists& l = local();
+					if( l.closed || l.counts[c] == max_cached_blocks ) {
+						::operator delete( ptr );
+						return;
+					}
+					// Release the cached blocks when the thread exits.
+					static thread_local guard release;
+					(void)release;
+					block* b = static_cast<block*>( ptr );
+					b->next = l.heads[c];
+					l.heads[c] = b;
+					++l.counts[c];
+				}
+
+			private:
+				/// A cached block
+				struct block {
+					block* next;
+				};
+
+				/// The cached blocks of a thread. This is trivially
+				/// destructible, so it's usable until the thread has exited,
+				/// even by thread local objects destroyed after the guard.
+				struct lists {
+					block* heads[class_count];
+					std::size_t counts[class_count];
+					bool closed;
+				};
+
+				/// Frees the cached blocks of a thread when it exits.
+				struct guard {
+					~guard() {
+						lists& l = local();
+						l.closed = true;
+						for( std::size_t c = 0; c < class_count; ++c ) {
+							while( l.heads[c] != nullptr ) {
+								block* b = l.heads[c];
+								l.heads[c] = b->next;
+								::operator delete( b );
+							}
+							l.counts[c] = 0;
+						}
+					}
+				};
+
+				static lists& local() {
+					static thread_local lists l{};
+					return l;
+				}
+
+				/// @returns The size class of a allocation, or `class_count`
+				///          if it's too large to be cached.
+				static std::size_t size_class( std::size_t size ) {
+					std::size_t c = 0;
+					while( c < class_count && (min_block_size << c) < size ) {
+						++c;
+					}
+					return c;
+				}
+		};
+	}
+
+	/// Allocator caching freed slot and snapshot storage for each thread.
 	///
-	/// This class is not really intended to instantiate by client code.
-	/// Instances are aquired as return values of the method `accumulate()`
-	/// called on signals.
+	/// Memory is allocated from the global allocator, but freed memory is
+	/// kept in a cache of the freeing thread, and reused by its following
+	/// allocations of a similar size. Once warmed up, repeatedly triggering
+	/// a signal takes its slot snapshots from the cache of the triggering
+	/// thread, without calling the global allocator.
 	///
-	/// @tparam S      Type of signal. The signal_accumulator acts
-	///                as a type of proxy for a signal instance of
-	///                this type.
-	/// @tparam T      Type of initial value of the accumulate algorithm.
-	///                This type must meet the requirements of `CopyAssignable`
-	///                and `CopyConstructible`
-	/// @tparam F      Type of accumulation function.
-	/// @tparam A...   Argument types of the underlying signal type.
+	/// The allocator is stateless, all instances compare equal.
 	///
-	template <class S, class T, class F, class...A>
-	class signal_accumulator
+	/// @tparam T   The type of objects to allocate.
+	template <class T>
+	class slot_pool_allocator
 	{
 		public:
-			/// Result type when calling the accumulating function operator.
-			using result_type = typename std::result_of<F(T, typename S::slot_type::result_type)>::type;
+			static_assert( alignof(T) <= alignof(std::max_align_t), "Over aligned types are not supported by the slot pool allocator." );
 
-			/// Construct a signal_accumulator as a proxy to a given signal
-			//
-			/// @param signal   Signal instance.
-			/// @param init     Initial value of the accumulate algorithm.
-			/// @param func     Binary operation function object that will be
-			///                 applied to all slot return values.
-			///                 The signature of the function should be
-			///                 equivalent of the following:
-			///                   `R func( T1 const& a, T2 const& b )`
-			///                  - The signature does not need to have `const&`.
-			///                  - The initial value, type `T`, must be implicitly
-			///                    convertible to `R`
-			///                  - The return type `R` must be implicitly convertible
-			///                    to type `T1`.
-			///                  - The type `R` must be `CopyAssignable`.
-			///                  - The type `S::slot_type::result_type` (return type of
-			///                    the signals slots) must be implicitly convertible to
-			///                    type `T2`.
-			signal_accumulator( S const& signal, T init, F func ) :
-				_signal( signal ),
-				_init( init ),
-				_func( func )
-			{}
+			using value_type = T;
 
-			/// Function call operator.
-			///
-			/// Calling this will trigger the underlying signal and accumulate
-			/// all of the connected slots return values with the current
-			/// initial value and accumulator function.
-			///
-			/// When called, this will invoke the accumulator function will
-			/// be called for each return value of the slots. The semantics
-			/// are similar to the `std::accumulate` algorithm.
-			///
-			/// @param args   Arguments to propagate to the slots of the
-			///               underlying when triggering the signal.
-			result_type operator()( A&&... args ) const {
-				return _signal.trigger_with_accumulator( _init, _func, std::forward<A>(args)... );
-			}
+			slot_pool_allocator() = default;
 
-		private:
+			template <class U>
+			slot_pool_allocator( slot_pool_allocator<U> const& ) {}
 
-			/// Reference to the underlying signal to proxy.
-			S const& _signal;
-			/// Initial value of the accumulate algorithm.
-			T _init;
-			/// Accumulator function.
-			F _func;
+			/// Allocate storage for `n` objects.
+			T* allocate( std::size_t n ) {
+				return static_cast<T*>( detail::block_cache::allocate( n * sizeof(T) ) );
+			}
 
+			/// Free storage for `n` objects, allocated with `allocate`.
+			void deallocate( T* ptr, std::size_t n ) {
+				detail::block_cache::deallocate( ptr, n * sizeof(T) );
+			}
 	};
 
-	/// Signal template specialization.
-	///
-	/// This is the main signal implementation, and it is used to
-	/// implement the observer pattern whithout the overhead
-	/// boilerplate code that typically comes with it.
-	///
-	/// Any function or function object is considered a slot, and
-	/// can be connected to a signal instance, as long as the signature
-	/// of the slot matches the signature of the signal.
+	template <class T, class U>
+	bool operator==( slot_pool_allocator<T> const&, slot_pool_allocator<U> const& ) {
+		return true;
+	}
+
+	template <class T, class U>
+	bool operator!=( slot_pool_allocator<T> const&, slot_pool_allocator<U> const& ) {
+		return false;
+	}
+
+	/// Thread policy allocating the slot storage of signals with a given
+	/// allocator, and otherwise behaving like the policy `P`.
 	///
-	/// @tparam P      Threading policy for the signal.
-	///                A threading policy must provide two type definitions:
-	///                 - P::mutex_type, this type will be used as a mutex
-	///                   in the signal_type class template.
-	///                 - P::mutex_lock_type, this type must implement a
-	///                   constructor that takes a P::mutex_type as a parameter,
-	///                   and it must have the semantics of a scoped mutex lock
-	///                   like std::lock_guard, i.e. locking in the constructor
-	///                   and unlocking in the destructor.
+	/// The allocator is rebound to the types stored by the signal, and
+	/// signals can be constructed with a allocator instance, so stateful
+	/// allocators like arenas can be used.
 	///
-	/// @tparam R      Return value type of the slots connected to the signal.
-	/// @tparam A...   Argument types of the slots connected to the signal.
-	template <class P, class R, class... A >
-	class signal_type<P,R(A...)>
+	/// @tparam A   The allocator, for any value type.
+	/// @tparam P   The thread policy to extend.
+	template <class A, class P = multithread_policy>
+	struct allocator_policy : P
 	{
-		public:
-			/// signals are not copy constructible
-			signal_type( signal_type const& ) = delete;
-			/// signals are not copy assignable
-			signal_type& operator=( signal_type const& ) = delete;
+		using allocator_type = A;
+	};
 
-			/// signals are default constructible
-			signal_type() :
-				_slot_count(0)
-			{}
+	/// Thread policy allocating the slot storage of signals from
+	/// `nod::slot_pool_allocator`, and otherwise behaving like the policy `P`.
+	template <class P = multithread_policy>
+	using slot_pool_policy = allocator_policy<slot_pool_allocator<char>, P>;
 
-			// Destruct the signal object.
-			~signal_type() {
-				invalidate_disconnector();
-			}
+	namespace detail {
+		/// Slot list storing the slots in a vector, which is the slot list
+		/// of the thread policies unless they provide another one.
+		///
+		/// A snapshot is a copy of the slots, so every emission calls its
+		/// own copies of the slots, and concurrent emissions never call the
+		/// same slot object. With the default allocator, the copies are
+		/// made into storage from the cache of the triggering thread, see
+		/// `nod::slot_pool_allocator`, so triggering a signal doesn't call
+		/// the global allocator once the cache is warmed up, including for
+		/// nested emissions.
+		///
+		/// @tparam T   The type of the slots.
+		/// @tparam A   The allocator of the slots.
+		template <class T, class A>
+		class flat_slot_list
+		{
+			using vector_type = std::vector<T, A>;
+			/// Allocator of the copies of the slots
+			using buffer_allocator = typename std::conditional<
+				std::is_same<A, std::allocator<T>>::value,
+				slot_pool_allocator<T>, A>::type;
+			using buffer_type = std::vector<T, buffer_allocator>;
 
-			/// Type that will be used to store the slots for this signal type.
-			using slot_type = std::function<R(A...)>;
-			/// Type that is used for counting the slots connected to this signal.
-			using size_type = typename std::vector<slot_type>::size_type;
+			public:
+				/// Snapshots are taken while holding the signal mutex.
+				static constexpr bool lock_free_snapshots = false;
 
+				/// Type returned when releasing a slot, `true` if the slot
+				/// was connected.
+				using released_type = bool;
 
-			/// Connect a new slot to the signal.
-			///
-			/// The connected slot will be called every time the signal
-			/// is triggered.
-			/// @param slot   The slot to connect. This must be a callable with
-			///               the same signature as the signal itself.
-			/// @return       A connection object is returned, and can be used to
-			///               disconnect the slot.
-			template <class T>
-			connection connect( T&& slot ) {
-				mutex_lock_type lock{ _mutex };
-				_slots.push_back( std::forward<T>(slot) );
-				std::size_t index = _slots.size()-1;
-				if( _shared_disconnector == nullptr ) {
-					_disconnector = disconnector{ this };
-					_shared_disconnector = std::shared_ptr<detail::disconnector>{&_disconnector, detail::no_delete};
+				/// The slots are constructed in the list, so this only
+				/// forwards the slot to `push_back`.
+				/// @param slot   The slot to forward.
+				template <class U>
+				static U&& make_node( A const&, U&& slot ) {
+					return std::forward<U>(slot);
 				}
-				++_slot_count;
-				return connection{ _shared_disconnector, index };
-			}
 
-			/// Function call operator.
-			///
-			/// Calling this is how the signal is triggered and the
-			/// connected slots are called.
-			///
-			/// @note The slots will be called in the order they were
-			///       connected to the signal.
-			///
-			/// @param args   Arguments that will be propagated to the
-			///               connected slots when they are called.
-			void operator()( A const&... args ) const {
-				for( auto const& slot : copy_slots() ) {
-					if( slot ) {
-						slot( args... );
+				/// Copy of the slots
+				class snapshot_type {
+					public:
+						/// @returns The number of slots, including empty slots.
+						std::size_t size() const {
+							return _slots.has_value() ? _slots.get().size() : 0;
+						}
+
+						/// @returns A pointer to the slot at a given index,
+						///          or `nullptr` if the slot is empty.
+						T const* operator[]( std::size_t index ) const {
+							T const& slot = _slots.get()[index];
+							return slot ? &slot : nullptr;
+						}
+
+					private:
+						friend class flat_slot_list;
+						lazy_value<buffer_type> _slots;
+				};
+
+				explicit flat_slot_list( A const& allocator = A() ) :
+					_slots( allocator )
+				{}
+
+				/// @returns The allocator of the slots.
+				A get_allocator() const {
+					return _slots.get_allocator();
+				}
+
+				/// @returns The number of slots, including empty slots.
+				std::size_t size() const {
+					return _slots.size();
+				}
+
+				/// @returns A copy of the slots.
+				snapshot_type snapshot() const {
+					snapshot_type result;
+					result._slots.emplace( _slots.begin(), _slots.end(), allocator_of_buffer( _slots.get_allocator() ) );
+					return result;
+				}
+
+				/// Add a slot at the end of the list.
+				/// @param slot   The slot to add.
+				template <class U>
+				void push_back( U&& slot, snapshot_type& ) {
+					_slots.emplace_back( std::forward<U>(slot) );
+				}
+
+				/// Empty the slot at a given index, and remove the empty
+				/// slots at the end of the list.
+				/// @param index   The index of the slot.
+				/// @returns       `true` if the slot was connected.
+				bool release( std::size_t index, snapshot_type& ) {
+					bool const released = _slots[index] != nullptr;
+					_slots[index] = nullptr;
+					while( _slots.size()>0 && !_slots.back() ) {
+						_slots.pop_back();
 					}
+					return released;
 				}
-			}
 
-			/// Construct a accumulator proxy object for the signal.
-			///
-			/// The intended purpose of this function is to create a function
-			/// object that can be used to trigger the signal and accumulate
-			/// all the slot return values.
-			///
-			/// The algorithm used to accumulate slot return values is similar
-			/// to `std::accumulate`. A given binary function is called for
-			/// each return value with the parameters consisting of the
-			/// return value of the accumulator function applied to the
-			/// previous slots return value, and the current slots return value.
-			/// A initial value must be provided for the first slot return type.
-			///
-			/// @note This can only be used on signals that have slots with
-			///       non-void return types, since we can't accumulate void
-			///       values.
-			///
-			/// @tparam T      The type of the initial value given to the accumulator.
-			/// @tparam F      The accumulator function type.
-			/// @param init    Initial value given to the accumulator.
-			/// @param op      Binary operator function object to apply by the accumulator.
-			///                The signature of the function should be
-			///                equivalent of the following:
-			///                  `R func( T1 const& a, T2 const& b )`
-			///                 - The signature does not need to have `const&`.
-			///                 - The initial value, type `T`, must be implicitly
-			///                   convertible to `R`
-			///                 - The return type `R` must be implicitly convertible
-			///                   to type `T1`.
-			///                 - The type `R` must be `CopyAssignable`.
-			///                 - The type `S::slot_type::result_type` (return type of
-			///                   the signals slots) must be implicitly convertible to
-			///                   type `T2`.
-			template <class T, class F>
-			signal_accumulator<signal_type, T, F, A...> accumulate( T init, F op ) const {
-				static_assert( std::is_same<R,void>::value == false, "Unable to accumulate slot return values with 'void' as return type." );
-				return { *this, init, op };
-			}
+				void swap( flat_slot_list& other ) {
+					_slots.swap( other._slots );
+				}
 
+			private:
+				/// @returns The allocator of the copies of the slots.
+				static slot_pool_allocator<T> allocator_of_buffer( std::allocator<T> const& ) {
+					return slot_pool_allocator<T>();
+				}
+				template <class U>
+				static U const& allocator_of_buffer( U const& allocator ) {
+					return allocator;
+				}
+
+				/// The slots, including empty slots followed by other slots.
+				vector_type _slots;
+		};
+
+		/// Slot list storing the slots in a vector, sharing its snapshots.
+		///
+		/// A snapshot is a shared immutable copy of the vector, that is
+		/// kept and handed out until the slots are modified. Taking a
+		/// snapshot after a modification copies the whole vector.
+		///
+		/// @tparam T   The type of the slots.
+		/// @tparam A   The allocator of the slots.
+		template <class T, class A>
+		class shared_flat_slot_list
+		{
+			using vector_type = std::vector<T, A>;
+
+			public:
+				/// Snapshots are taken while holding the signal mutex.
+				static constexpr bool lock_free_snapshots = false;
+
+				/// Immutable snapshot of the slots
+				class snapshot_type {
+					public:
+						snapshot_type() = default;
+
+						/// @returns The number of slots, including empty slots.
+						std::size_t size() const {
+							return _slots ? _slots->size() : 0;
+						}
+
+						/// @returns The slot at a given index.
+						T const& operator[]( std::size_t index ) const {
+							return (*_slots)[index];
+						}
+
+					private:
+						friend class shared_flat_slot_list;
+						std::shared_ptr<vector_type const> _slots;
+				};
+
+				explicit shared_flat_slot_list( A const& allocator = A() ) :
+					_slots( allocator )
+				{}
+
+				/// @returns The allocator of the slots.
+				A get_allocator() const {
+					return _slots.get_allocator();
+				}
+
+				/// @returns The number of slots, including empty slots.
+				std::size_t size() const {
+					return _slots.size();
+				}
+
+				/// @returns A snapshot of the slots, shared with the other
+				///          snapshots taken since the last modification.
+				snapshot_type snapshot() const {
+					if( !_snapshot._slots ) {
+						_snapshot._slots = std::allocate_shared<vector_type>( _slots.get_allocator(), _slots );
+					}
+					return _snapshot;
+				}
+
+				/// Add a slot at the end of the list.
+				/// @param value   The slot to add.
+				/// @param stale   Receives the snapshot made stale by the
+				///                modification, to be released by the caller.
+				void push_back( T value, snapshot_type& stale ) {
+					_slots.push_back( std::move(value) );
+					stale = std::move( _snapshot );
+				}
+
+				/// Empty the slot at a given index, and remove the empty
+				/// slots at the end of the list.
+				/// @param index   The index of the slot.
+				/// @param stale   Receives the snapshot made stale by the
+				///                modification, to be released by the caller.
+				/// @returns       The removed slot.
+				T release( std::size_t index, snapshot_type& stale ) {
+					T released = std::move( _slots[index] );
+					while( _slots.size()>0 && !_slots.back() ) {
+						_slots.pop_back();
+					}
+					stale = std::move( _snapshot );
+					return released;
+				}
+
+				void swap( shared_flat_slot_list& other ) {
+					_slots.swap( other._slots );
+					std::swap( _snapshot, other._snapshot );
+				}
+
+			private:
+				/// The slots, including empty slots followed by other slots.
+				vector_type _slots;
+				/// Snapshot taken since the last modification, if any.
+				mutable snapshot_type _snapshot;
+		};
+
+		/// Slot list storing the slots in a persistent vector.
+		///
+		/// The slots are stored in a tree of nodes with 32 children each,
+		/// with the last up to 32 slots kept in a separate tail node. Nodes
+		/// are immutable once shared: a modification copies the nodes on the
+		/// path to the modified slot and shares the rest with the previous
+		/// version. A snapshot is a version of the list, which is taken by
+		/// copying a few pointers, and is unaffected by later modifications.
+		///
+		/// Adding a slot is O(1) amortized, and emptying a slot is O(log n),
+		/// independent of the snapshots taken in between. Accessing a slot
+		/// of a snapshot is O(log n), with a base of 32.
+		///
+		/// @tparam T   The type of the slots.
+		/// @tparam A   The allocator of the slots.
+		template <class T, class A>
+		class persistent_slot_list
+		{
+			static constexpr unsigned bits = 5;
+			static constexpr std::size_t width = std::size_t(1) << bits;
+			static constexpr std::size_t mask = width - 1;
+
+			/// Node holding slots
+			struct leaf {
+				T values[width];
+			};
+			/// Node holding other nodes
+			struct branch {
+				std::shared_ptr<void const> children[width];
+			};
+			using node_ptr = std::shared_ptr<void const>;
+			using leaf_ptr = std::shared_ptr<leaf const>;
+
+			public:
+				/// Snapshots are taken while holding the signal mutex.
+				static constexpr bool lock_free_snapshots = false;
+
+				/// Immutable version of the slot list
+				class snapshot_type {
+					public:
+						snapshot_type() :
+							_size( 0 ),
+							_shift( bits )
+						{}
+
+						/// @returns The number of slots, including empty slots.
+						std::size_t size() const {
+							return _size;
+						}
+
+						/// @returns The slot at a given index.
+						T const& operator[]( std::size_t index ) const {
+							return leaf_for( index )->values[index & mask];
+						}
+
+					private:
+						friend class persistent_slot_list;
+
+						/// @returns The index of the first slot in the tail.
+						std::size_t tail_offset() const {
+							return _size < width ? 0 : ((_size - 1) >> bits) << bits;
+						}
+
+						/// @returns The leaf holding the slot at a given index.
+						leaf const* leaf_for( std::size_t index ) const {
+							if( index >= tail_offset() ) {
+								return _tail.get();
+							}
+							void const* node = _root.get();
+							for( unsigned level = _shift; level > 0; level -= bits ) {
+								node = static_cast<branch const*>( node )->children[(index >> level) & mask].get();
+							}
+							return static_cast<leaf const*>( node );
+						}
+
+						/// @returns The leaf of the tree holding the slot at a
+						///          given index, which must be before the tail.
+						node_ptr const& leaf_node( std::size_t index ) const {
+							node_ptr const* node = &_root;
+							for( unsigned level = _shift; level > 0; level -= bits ) {
+								node = &static_cast<branch const*>( node->get() )->children[(index >> level) & mask];
+							}
+							return *node;
+						}
+
+						/// Root of the tree, holding all slots before the tail.
+						node_ptr _root;
+						/// The last slots.
+						leaf_ptr _tail;
+						/// Number of slots
+						std::size_t _size;
+						/// Bit shift of the slot index for the root level.
+						unsigned _shift;
+				};
+
+				explicit persistent_slot_list( A const& allocator = A() ) :
+					_allocator( allocator )
+				{}
+
+				/// @returns The allocator of the slots.
+				A get_allocator() const {
+					return _allocator;
+				}
+
+				/// @returns The number of slots, including empty slots.
+				std::size_t size() const {
+					return _current._size;
+				}
+
+				/// @returns The current version of the list.
+				snapshot_type snapshot() const {
+					return _current;
+				}
+
+				/// Add a slot at the end of the list.
+				/// @param value   The slot to add.
+				void push_back( T value, snapshot_type& /*stale*/ ) {
+					auto& v = _current;
+					std::size_t const in_tail = v._size - v.tail_offset();
+					if( in_tail < width ) {
+						std::shared_ptr<leaf> tail = writable_tail();
+						tail->values[in_tail] = std::move( value );
+						v._tail = std::move( tail );
+					}
+					else {
+						// Move the full tail into the tree, adding a level
+						// when the tree is full.
+						if( (v._size >> bits) > (std::size_t(1) << v._shift) ) {
+							std::shared_ptr<branch> root = make_branch( nullptr );
+							root->children[0] = std::move( v._root );
+							root->children[1] = new_path( v._shift, v._tail );
+							v._root = std::move( root );
+							v._shift += bits;
+						}
+						else {
+							v._root = push_tail( v._shift, static_cast<branch const*>( v._root.get() ) );
+						}
+						std::shared_ptr<leaf> tail = make_leaf( nullptr );
+						tail->values[0] = std::move( value );
+						v._tail = std::move( tail );
+					}
+					++v._size;
+				}
+
+				/// Empty the slot at a given index, and remove the empty
+				/// slots at the end of the list.
+				/// @param index   The index of the slot.
+				/// @returns       The removed slot.
+				T release( std::size_t index, snapshot_type& /*stale*/ ) {
+					auto& v = _current;
+					T released = v[index];
+					if( index >= v.tail_offset() ) {
+						std::shared_ptr<leaf> tail = writable_tail();
+						tail->values[index & mask] = T{};
+						v._tail = std::move( tail );
+					}
+					else {
+						v._root = assign( v._shift, v._root.get(), index );
+					}
+					while( v._size > 0 && !v[v._size - 1] ) {
+						pop_back();
+					}
+					return released;
+				}
+
+				void swap( persistent_slot_list& other ) {
+					std::swap( _current, other._current );
+					std::swap( _allocator, other._allocator );
+				}
+
+			private:
+				std::shared_ptr<leaf> make_leaf( leaf const* from ) const {
+					return from ? std::allocate_shared<leaf>( _allocator, *from ) : std::allocate_shared<leaf>( _allocator );
+				}
+
+				std::shared_ptr<branch> make_branch( branch const* from ) const {
+					return from ? std::allocate_shared<branch>( _allocator, *from ) : std::allocate_shared<branch>( _allocator );
+				}
+
+				/// @returns The tail, if it's only referenced by the list,
+				///          or a copy of it otherwise.
+				std::shared_ptr<leaf> writable_tail() const {
+					if( _current._tail.use_count() == 1 ) {
+						// Synchronize with the snapshots releasing the tail.
+						std::atomic_thread_fence( std::memory_order_acquire );
+						return std::const_pointer_cast<leaf>( _current._tail );
+					}
+					return make_leaf( _current._tail.get() );
+				}
+
+				/// @returns A chain of branches down to a node at a given level.
+				node_ptr new_path( unsigned level, node_ptr node ) const {
+					if( level == 0 ) {
+						return node;
+					}
+					std::shared_ptr<branch> b = make_branch( nullptr );
+					b->children[0] = new_path( level - bits, std::move(node) );
+					return b;
+				}
+
+				/// @returns A copy of the branch `parent` at `level`, with the
+				///          tail added as its last leaf.
+				node_ptr push_tail( unsigned level, branch const* parent ) const {
+					std::shared_ptr<branch> result = make_branch( parent );
+					std::size_t const sub = ((_current._size - 1) >> level) & mask;
+					if( level == bits ) {
+						result->children[sub] = _current._tail;
+					}
+					else if( result->children[sub] ) {
+						result->children[sub] = push_tail( level - bits, static_cast<branch const*>( result->children[sub].get() ) );
+					}
+					else {
+						result->children[sub] = new_path( level - bits, _current._tail );
+					}
+					return result;
+				}
+
+				/// @returns A copy of `node` at `level`, with the slot at
+				///          `index` emptied.
+				node_ptr assign( unsigned level, void const* node, std::size_t index ) const {
+					if( level == 0 ) {
+						std::shared_ptr<leaf> l = make_leaf( static_cast<leaf const*>( node ) );
+						l->values[index & mask] = T{};
+						return l;
+					}
+					std::shared_ptr<branch> b = make_branch( static_cast<branch const*>( node ) );
+					std::size_t const sub = (index >> level) & mask;
+					b->children[sub] = assign( level - bits, b->children[sub].get(), index );
+					return b;
+				}
+
+				/// Remove the last slot.
+				void pop_back() {
+					auto& v = _current;
+					if( v._size == 1 ) {
+						v = snapshot_type{};
+						return;
+					}
+					std::size_t const in_tail = v._size - v.tail_offset();
+					if( in_tail > 1 ) {
+						std::shared_ptr<leaf> tail = writable_tail();
+						tail->values[in_tail - 1] = T{};
+						v._tail = std::move( tail );
+					}
+					else {
+						// The last leaf of the tree becomes the tail.
+						leaf_ptr tail = std::static_pointer_cast<leaf const>( v.leaf_node( v._size - 2 ) );
+						node_ptr root = pop_tail( v._shift, static_cast<branch const*>( v._root.get() ) );
+						if( !root ) {
+							v._shift = bits;
+						}
+						else if( v._shift > bits && !static_cast<branch const*>( root.get() )->children[1] ) {
+							root = static_cast<branch const*>( root.get() )->children[0];
+							v._shift -= bits;
+						}
+						v._root = std::move( root );
+						v._tail = std::move( tail );
+					}
+					--v._size;
+				}
+
+				/// @returns A copy of the branch `node` at `level` without its
+				///          last leaf, or null if it would be empty.
+				node_ptr pop_tail( unsigned level, branch const* node ) const {
+					std::size_t const sub = ((_current._size - 2) >> level) & mask;
+					if( level > bits ) {
+						node_ptr child = pop_tail( level - bits, static_cast<branch const*>( node->children[sub].get() ) );
+						if( !child && sub == 0 ) {
+							return nullptr;
+						}
+						std::shared_ptr<branch> b = make_branch( node );
+						b->children[sub] = std::move( child );
+						return b;
+					}
+					if( sub == 0 ) {
+						return nullptr;
+					}
+					std::shared_ptr<branch> b = make_branch( node );
+					b->children[sub] = nullptr;
+					return b;
+				}
+
+				/// The current version of the list
+				snapshot_type _current;
+				/// Allocator of the nodes
+				A _allocator;
+		};
+
+		/// Epochs of the threads reading seqlock slot lists.
+		///
+		/// Memory removed from a seqlock slot list by a writer may still be
+		/// read by emissions in progress on other threads. Writers retire
+		/// such memory with a new epoch, and it's only freed once no thread
+		/// is reading with an earlier epoch. Each reading thread publishes
+		/// its epoch in a record of its own, on a cache line that isn't
+		/// shared with other threads, so reading never writes memory shared
+		/// with other threads.
+		///
+		/// Retired memory is freed by the writer retiring it if no thread is
+		/// reading, and otherwise by the last of the reads in progress when
+		/// it was retired, as that read ends. Reads started later don't wait
+		/// for it and don't free it.
+		class reader_epochs {
+			public:
+				/// Epoch record of a thread
+				struct record {
+					/// Padding keeping the epoch on a cache line of its own
+					char before[64];
+					/// Epoch the thread is reading with, or 0 if it isn't
+					/// reading.
+					std::atomic<std::uint64_t> epoch;
+					/// Number of nested reads of the thread
+					std::size_t depth;
+					/// `true` while the record is owned by a thread
+					bool in_use;
+					char after[64];
+				};
+
+				/// A read in progress by the calling thread, keeping the
+				/// memory it may read from being freed.
+				///
+				/// The read must end on the thread that started it.
+				class pin {
+					public:
+						pin() :
+							_record( &local() )
+						{
+							if( _record->depth++ == 0 ) {
+								_record->epoch.store( current().load( std::memory_order_acquire ), std::memory_order_relaxed );
+								// Publish the epoch before reading anything.
+								std::atomic_thread_fence( std::memory_order_seq_cst );
+							}
+						}
+
+						pin( pin&& other ) :
+							_record( other._record )
+						{
+							other._record = nullptr;
+						}
+
+						pin( pin const& ) = delete;
+						pin& operator=( pin const& ) = delete;
+
+						~pin() {
+							if( _record != nullptr && --_record->depth == 0 ) {
+								std::uint64_t const epoch = _record->epoch.load( std::memory_order_relaxed );
+								_record->epoch.store( 0, std::memory_order_release );
+								// Pairs with the fence of the writers in
+								// `reclaim()`: either the writer sees this
+								// read has ended, or this read sees the memory
+								// retired while it was in progress.
+								std::atomic_thread_fence( std::memory_order_seq_cst );
+								if( epoch < instance().newest.load( std::memory_order_relaxed ) ) {
+									reclaim();
+								}
+							}
+						}
+
+					private:
+						record* _record;
+				};
+
+				/// Keep memory that has been removed from the view of new
+				/// readers until no thread can be reading it.
+				/// @param memory   The memory, which is freed by releasing it.
+				static void retire( std::shared_ptr<void const> memory ) {
+					registry& r = instance();
+					std::lock_guard<std::mutex> lock{ r.mutex };
+					std::uint64_t const epoch = current().fetch_add( 1, std::memory_order_seq_cst ) + 1;
+					r.memory.push_back( retired{ epoch, std::move(memory) } );
+					r.newest.store( epoch, std::memory_order_relaxed );
+				}
+
+				/// Free the retired memory no thread is reading anymore.
+				///
+				/// The memory is released after unlocking the registry, so
+				/// destroying it may read and modify seqlock slot lists.
+				static void reclaim() {
+					std::vector<retired> freed;
+					registry& r = instance();
+					std::atomic_thread_fence( std::memory_order_seq_cst );
+					std::lock_guard<std::mutex> lock{ r.mutex };
+					if( r.memory.empty() ) {
+						return;
+					}
+					std::uint64_t oldest = current().load( std::memory_order_relaxed );
+					for( auto const& rec : r.records ) {
+						std::uint64_t const epoch = rec->epoch.load( std::memory_order_acquire );
+						if( epoch != 0 && epoch < oldest ) {
+							oldest = epoch;
+						}
+					}
+					auto const kept = std::partition( r.memory.begin(), r.memory.end(), [oldest]( retired const& m ) {
+						return m.epoch > oldest;
+					} );
+					freed.assign( std::make_move_iterator( kept ), std::make_move_iterator( r.memory.end() ) );
+					r.memory.erase( kept, r.memory.end() );
+				}
+
+			private:
+				/// Memory retired by a writer
+				struct retired {
+					/// Epoch the memory was retired with
+					std::uint64_t epoch;
+					std::shared_ptr<void const> memory;
+				};
+
+				/// All records, including records of exited threads, which
+				/// are reused by new threads, and the retired memory.
+				struct registry {
+					std::mutex mutex;
+					std::vector<std::unique_ptr<record>> records;
+					/// Retired memory that may still be read
+					std::vector<retired> memory;
+					/// Newest epoch memory was retired with
+					std::atomic<std::uint64_t> newest{ 0 };
+				};
+
+				/// Releases the record of a thread when it exits
+				struct owner {
+					record* rec;
+					~owner() {
+						registry& r = instance();
+						std::lock_guard<std::mutex> lock{ r.mutex };
+						rec->in_use = false;
+					}
+				};
+
+				/// The registry is never destroyed, so signals destroyed
+				/// during static destruction can still retire memory.
+				static registry& instance() {
+					static registry* r = new registry();
+					return *r;
+				}
+
+				static std::atomic<std::uint64_t>& current() {
+					static std::atomic<std::uint64_t> epoch{ 1 };
+					return epoch;
+				}
+
+				static record* acquire() {
+					registry& r = instance();
+					std::lock_guard<std::mutex> lock{ r.mutex };
+					for( auto& rec : r.records ) {
+						if( !rec->in_use ) {
+							rec->in_use = true;
+							return rec.get();
+						}
+					}
+					std::unique_ptr<record> rec{ new record() };
+					rec->epoch.store( 0, std::memory_order_relaxed );
+					rec->depth = 0;
+					rec->in_use = true;
+					r.records.push_back( std::move(rec) );
+					return r.records.back().get();
+				}
+
+				static record& local() {
+					static thread_local owner o{ acquire() };
+					return *o.rec;
+				}
+		};
+
+		/// Slot list protected by a sequence lock for emissions.
+		///
+		/// Emissions read the slot pointers optimistically, without
+		/// locking: the sequence number is read before and after copying
+		/// the pointers, and the copy is retried if a writer modified the
+		/// list meanwhile. Writers, which hold the signal mutex, make the
+		/// sequence number odd while modifying the list and publish the
+		/// modification by making it even again.
+		///
+		/// The copy is made to a buffer reused by the thread, and the slots
+		/// and arrays removed by writers are kept alive by the epochs of the
+		/// readers, so emissions write neither shared reference counts nor
+		/// the mutex. Disconnected slots are destroyed once no emission can
+		/// be calling them, by the writer or by the last emission that was
+		/// in progress when they were disconnected, see `reader_epochs`.
+		///
+		/// @tparam T   The type of the slots, a shared pointer.
+		/// @tparam A   The allocator of the slots.
+		/// @tparam Y   The thread policy, whose `yield_thread()` is called
+		///             before retrying a copy.
+		template <class T, class A, class Y>
+		class seqlock_slot_list
+		{
+			/// Plain pointer to a slot
+			using pointer = decltype( std::declval<T const&>().get() );
+
+			/// Array of slot pointers, read by emissions
+			struct slot_array {
+				explicit slot_array( std::size_t c ) :
+					capacity( c ),
+					slots( new std::atomic<pointer>[c] )
+				{}
+				std::size_t capacity;
+				std::unique_ptr<std::atomic<pointer>[]> slots;
+			};
+
+			/// Buffers for the copies made by emissions, reused by the thread
+			using buffer_type = std::vector<void const*>;
+
+			static std::vector<buffer_type>& buffer_pool() {
+				static thread_local std::vector<buffer_type> pool;
+				return pool;
+			}
+
+			public:
+				/// Emissions take snapshots without locking the signal mutex.
+				static constexpr bool lock_free_snapshots = true;
+
+				/// Copy of the slot pointers, taken by an emission.
+				///
+				/// The slots are kept alive until the snapshot is destroyed,
+				/// which must be on the thread that took the snapshot.
+				class snapshot_type {
+					public:
+						snapshot_type() = default;
+						snapshot_type( snapshot_type&& ) = default;
+
+						~snapshot_type() {
+							if( _buffer.capacity() > 0 ) {
+								auto& pool = buffer_pool();
+								if( pool.size() < 16 ) {
+									pool.push_back( std::move(_buffer) );
+								}
+							}
+						}
+
+						/// @returns The number of slots, including empty slots.
+						std::size_t size() const {
+							return _buffer.size();
+						}
+
+						/// @returns A pointer to the slot at a given index,
+						///          which is null for empty slots.
+						pointer operator[]( std::size_t index ) const {
+							return static_cast<pointer>( _buffer[index] );
+						}
+
+					private:
+						friend class seqlock_slot_list;
+
+						/// Keeps the slots alive
+						lazy_value<reader_epochs::pin> _pin;
+						/// The slot pointers
+						buffer_type _buffer;
+				};
+
+				explicit seqlock_slot_list( A const& allocator = A() ) :
+					_slots( allocator ),
+					_sequence( 0 ),
+					_array( nullptr ),
+					_size( 0 )
+				{}
+
+				seqlock_slot_list( seqlock_slot_list const& ) = delete;
+				seqlock_slot_list& operator=( seqlock_slot_list const& ) = delete;
+
+				~seqlock_slot_list() {
+					// Emissions in progress and ranges of results may still
+					// read the slots.
+					for( auto& slot : _slots ) {
+						if( slot ) {
+							reader_epochs::retire( std::move(slot) );
+						}
+					}
+					retire( std::unique_ptr<slot_array>( _array.load( std::memory_order_relaxed ) ) );
+					reader_epochs::reclaim();
+				}
+
+				/// @returns The allocator of the slots.
+				A get_allocator() const {
+					return _slots.get_allocator();
+				}
+
+				/// @returns The number of slots, including empty slots.
+				std::size_t size() const {
+					return _slots.size();
+				}
+
+				/// @returns A copy of the slot pointers. This may be called
+				///          without holding the signal mutex.
+				snapshot_type snapshot() const {
+					snapshot_type s;
+					s._pin.emplace();
+					auto& pool = buffer_pool();
+					if( !pool.empty() ) {
+						s._buffer = std::move( pool.back() );
+						pool.pop_back();
+					}
+					for( ;; ) {
+						std::uint64_t const before = _sequence.load( std::memory_order_acquire );
+						if( (before & 1) == 0 ) {
+							slot_array const* array = _array.load( std::memory_order_relaxed );
+							// A torn read is discarded below, but must stay
+							// within the array that was read.
+							std::size_t const size = std::min( _size.load( std::memory_order_relaxed ), array ? array->capacity : 0 );
+							s._buffer.resize( size );
+							for( std::size_t i = 0; i < size; ++i ) {
+								s._buffer[i] = array->slots[i].load( std::memory_order_relaxed );
+							}
+							std::atomic_thread_fence( std::memory_order_acquire );
+							if( _sequence.load( std::memory_order_relaxed ) == before ) {
+								return s;
+							}
+						}
+						Y::yield_thread();
+					}
+				}
+
+				/// Add a slot at the end of the list.
+				/// @param value   The slot to add.
+				void push_back( T value, snapshot_type& /*stale*/ ) {
+					pointer const slot = value.get();
+					std::size_t const index = _slots.size();
+					_slots.push_back( std::move(value) );
+					slot_array* array = _array.load( std::memory_order_relaxed );
+					std::unique_ptr<slot_array> replaced;
+					if( array == nullptr || array->capacity == index ) {
+						replaced.reset( array );
+						array = new slot_array( std::max<std::size_t>( 2 * index, 8 ) );
+						for( std::size_t i = 0; i < index; ++i ) {
+							array->slots[i].store( replaced->slots[i].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+						}
+					}
+					begin_write();
+					array->slots[index].store( slot, std::memory_order_relaxed );
+					_array.store( array, std::memory_order_relaxed );
+					_size.store( index + 1, std::memory_order_relaxed );
+					end_write();
+					retire( std::move(replaced) );
+					reader_epochs::reclaim();
+				}
+
+				/// Empty the slot at a given index, and remove the empty
+				/// slots at the end of the list.
+				/// @param index   The index of the slot.
+				/// @returns       The removed slot.
+				T release( std::size_t index, snapshot_type& /*stale*/ ) {
+					T released = std::move( _slots[index] );
+					while( _slots.size()>0 && !_slots.back() ) {
+						_slots.pop_back();
+					}
+					begin_write();
+					_array.load( std::memory_order_relaxed )->slots[index].store( nullptr, std::memory_order_relaxed );
+					_size.store( _slots.size(), std::memory_order_relaxed );
+					end_write();
+					if( released ) {
+						reader_epochs::retire( released );
+					}
+					reader_epochs::reclaim();
+					return released;
+				}
+
+				/// Exchange the slots with another list, that must not be
+				/// read by emissions.
+				void swap( seqlock_slot_list& other ) {
+					_slots.swap( other._slots );
+					std::unique_ptr<slot_array> replaced{ _array.load( std::memory_order_relaxed ) };
+					begin_write();
+					_array.store( other.publish( _slots ), std::memory_order_relaxed );
+					_size.store( _slots.size(), std::memory_order_relaxed );
+					end_write();
+					delete other._array.exchange( other.publish( other._slots ), std::memory_order_relaxed );
+					other._size.store( other._slots.size(), std::memory_order_relaxed );
+					// The slots moved to the other list are destroyed with it,
+					// so keep them alive for the emissions of this one.
+					for( auto const& slot : other._slots ) {
+						if( slot ) {
+							reader_epochs::retire( slot );
+						}
+					}
+					retire( std::move(replaced) );
+					reader_epochs::reclaim();
+				}
+
+			private:
+				void begin_write() {
+					_sequence.store( _sequence.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+					std::atomic_thread_fence( std::memory_order_release );
+				}
+
+				void end_write() {
+					_sequence.store( _sequence.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+				}
+
+				/// @returns A new array with pointers to given slots.
+				static slot_array* publish( std::vector<T, A> const& slots ) {
+					if( slots.empty() ) {
+						return nullptr;
+					}
+					slot_array* array = new slot_array( slots.size() );
+					for( std::size_t i = 0; i < slots.size(); ++i ) {
+						array->slots[i].store( slots[i].get(), std::memory_order_relaxed );
+					}
+					return array;
+				}
+
+				/// Keep a array removed from the view of emissions until no
+				/// emission can be reading it.
+				static void retire( std::unique_ptr<slot_array> array ) {
+					if( array ) {
+						reader_epochs::retire( std::shared_ptr<slot_array const>( std::move(array) ) );
+					}
+				}
+
+				/// The slots, owned by the list. Only used by writers.
+				std::vector<T, A> _slots;
+				/// Sequence number, odd while a writer modifies the list.
+				std::atomic<std::uint64_t> _sequence;
+				/// Slot pointers read by emissions
+				std::atomic<slot_array*> _array;
+				/// Number of slot pointers read by emissions
+				std::atomic<std::size_t> _size;
+		};
+
+		/// Slot storage of thread safe homogeneous signals.
+		///
+		/// The slots are kept in a contiguous array, that emissions share
+		/// while calling the slots. The array is modified in place when no
+		/// emission holds it, and otherwise replaced by a modified copy,
+		/// leaving the array of the emissions in progress unchanged.
+		///
+		/// The signal mutex must be held while calling any member function.
+		///
+		/// @tparam E   The type of the slot entries.
+		/// @tparam A   The allocator of the entries.
+		template <class E, class A>
+		class shared_entries
+		{
+			using vector_type = std::vector<E, A>;
+
+			public:
+				/// Array replaced by a modification, to be released by the
+				/// caller after unlocking the signal mutex.
+				using stale_type = std::shared_ptr<vector_type>;
+
+				/// The entries seen by a emission
+				class view_type {
+					public:
+						/// @returns The number of entries
+						std::size_t size() const {
+							return _size;
+						}
+
+						/// @returns The entry at a given index
+						E& operator[]( std::size_t index ) const {
+							return _data[index];
+						}
+
+					private:
+						friend class shared_entries;
+						/// Keeps the entries alive
+						std::shared_ptr<vector_type> _entries;
+						E* _data = nullptr;
+						std::size_t _size = 0;
+				};
+
+				explicit shared_entries( A const& allocator = A() ) :
+					_allocator( allocator )
+				{}
+
+				/// @returns The allocator of the entries.
+				A get_allocator() const {
+					return _allocator;
+				}
+
+				/// @returns The number of entries, including disconnected entries.
+				std::size_t size() const {
+					return _entries ? _entries->size() : 0;
+				}
+
+				/// @returns The entries, shared with the other emissions.
+				view_type view() const {
+					view_type v;
+					if( _entries ) {
+						v._entries = _entries;
+						v._data = _entries->data();
+						v._size = _entries->size();
+					}
+					return v;
+				}
+
+				/// Add a entry at the end.
+				/// @returns The index of the entry.
+				std::size_t push_back( E entry, stale_type& stale ) {
+					auto& entries = modify( stale );
+					entries.push_back( std::move(entry) );
+					return entries.size() - 1;
+				}
+
+				/// Disconnect the entry at a given index, and remove the
+				/// disconnected entries at the end.
+				/// @returns `true` if the entry was connected.
+				bool release( std::size_t index, stale_type& stale ) {
+					auto& entries = modify( stale );
+					bool const connected = entries[index].connected;
+					entries[index].connected = false;
+					while( entries.size()>0 && !entries.back().connected ) {
+						entries.pop_back();
+					}
+					return connected;
+				}
+
+				/// Remove all entries.
+				void clear( stale_type& stale ) {
+					stale = std::move( _entries );
+				}
+
+			private:
+				/// @returns The entries, which are copied first if they are
+				///          shared with emissions.
+				vector_type& modify( stale_type& stale ) {
+					if( !_entries ) {
+						// Constructed from a empty vector, since allocators
+						// like std::pmr::polymorphic_allocator pass themselves
+						// to the constructor as a trailing argument.
+						_entries = std::allocate_shared<vector_type>( _allocator, vector_type( _allocator ) );
+					}
+					else if( !unique() ) {
+						stale = _entries;
+						_entries = std::allocate_shared<vector_type>( _allocator, *stale );
+					}
+					return *_entries;
+				}
+
+				/// @returns `true` if no emission holds the entries.
+				bool unique() const {
+#ifdef NOD_THREAD_SANITIZER
+					return false;
+#else
+					if( _entries.use_count() != 1 ) {
+						return false;
+					}
+					// Synchronize with the emissions that released the
+					// entries, since they may have modified the slots.
+					std::atomic_thread_fence( std::memory_order_acquire );
+					return true;
+#endif
+				}
+
+				A _allocator;
+				/// The entries, including disconnected entries followed by
+				/// connected entries.
+				std::shared_ptr<vector_type> _entries;
+		};
+
+		/// Slot storage of homogeneous signals that are not thread safe.
+		///
+		/// Emissions call the slots in the storage directly. Entries added
+		/// while the signal is triggered are kept aside, and disconnected
+		/// entries are kept in place, until the outermost emission has
+		/// finished, so the slots don't move while they are called.
+		///
+		/// @tparam E   The type of the slot entries.
+		/// @tparam A   The allocator of the entries.
+		template <class E, class A>
+		class direct_entries
+		{
+			using vector_type = std::vector<E, A>;
+
+			public:
+				/// Nothing is released after unlocking the signal mutex.
+				struct stale_type {};
+
+				/// The entries seen by a emission
+				class view_type {
+					public:
+						view_type( view_type&& other ) :
+							_owner( other._owner ),
+							_data( other._data ),
+							_size( other._size )
+						{
+							other._owner = nullptr;
+						}
+
+						view_type( view_type const& ) = delete;
+						view_type& operator=( view_type const& ) = delete;
+
+						~view_type() {
+							if( _owner ) {
+								_owner->end_emission();
+							}
+						}
+
+						/// @returns The number of entries
+						std::size_t size() const {
+							return _size;
+						}
+
+						/// @returns The entry at a given index
+						E& operator[]( std::size_t index ) const {
+							return _data[index];
+						}
+
+					private:
+						friend class direct_entries;
+						view_type( direct_entries const* owner, E* data, std::size_t size ) :
+							_owner( owner ),
+							_data( data ),
+							_size( size )
+						{}
+						direct_entries const* _owner;
+						E* _data;
+						std::size_t _size;
+				};
+
+				explicit direct_entries( A const& allocator = A() ) :
+					_entries( allocator ),
+					_pending( allocator ),
+					_depth( 0 )
+				{}
+
+				/// @returns The allocator of the entries.
+				A get_allocator() const {
+					return _entries.get_allocator();
+				}
+
+				/// @returns The number of entries, including disconnected entries.
+				std::size_t size() const {
+					return _entries.size() + _pending.size();
+				}
+
+				/// @returns The entries, until the returned view is destroyed.
+				view_type view() const {
+					++_depth;
+					return { this, _entries.data(), _entries.size() };
+				}
+
+				/// Add a entry at the end.
+				/// @returns The index of the entry.
+				std::size_t push_back( E entry, stale_type& ) {
+					if( _depth > 0 ) {
+						_pending.push_back( std::move(entry) );
+					}
+					else {
+						_entries.push_back( std::move(entry) );
+					}
+					return size() - 1;
+				}
+
+				/// Disconnect the entry at a given index, and remove the
+				/// disconnected entries at the end unless the signal is
+				/// being triggered.
+				/// @returns `true` if the entry was connected.
+				bool release( std::size_t index, stale_type& ) {
+					E& entry = index < _entries.size() ? _entries[index] : _pending[index - _entries.size()];
+					bool const connected = entry.connected;
+					entry.connected = false;
+					if( _depth == 0 ) {
+						trim();
+					}
+					return connected;
+				}
+
+				/// Remove all entries, or disconnect them if the signal is
+				/// being triggered.
+				void clear( stale_type& ) {
+					if( _depth == 0 ) {
+						_entries.clear();
+						return;
+					}
+					for( auto& entry : _entries ) {
+						entry.connected = false;
+					}
+					for( auto& entry : _pending ) {
+						entry.connected = false;
+					}
+				}
+
+			private:
+				/// Apply the modifications made while the signal was triggered,
+				/// once the outermost emission has finished.
+				void end_emission() const {
+					if( --_depth == 0 ) {
+						for( auto& entry : _pending ) {
+							_entries.push_back( std::move(entry) );
+						}
+						_pending.clear();
+						trim();
+					}
+				}
+
+				/// Remove the disconnected entries at the end.
+				void trim() const {
+					while( _entries.size()>0 && !_entries.back().connected ) {
+						_entries.pop_back();
+					}
+				}
+
+				/// The entries, including disconnected entries followed by
+				/// connected entries.
+				mutable vector_type _entries;
+				/// Entries added while the signal is triggered
+				mutable vector_type _pending;
+				/// Number of emissions in progress
+				mutable std::size_t _depth;
+		};
+
+		/// Slot list storing each slot once, in a shared immutable node, in
+		/// a list of nodes.
+		///
+		/// Snapshots of the list hold the nodes, so emissions call the
+		/// connected slot objects themselves, and a disconnected slot is
+		/// kept alive until the emissions calling it have finished.
+		///
+		/// @tparam T   The type of the slots.
+		/// @tparam A   The allocator of the slots.
+		/// @tparam L   The list of nodes, like `shared_flat_slot_list`.
+		template <class T, class A, template <class, class> class L>
+		class shared_slots :
+			public L<std::shared_ptr<T const>, typename std::allocator_traits<A>::template rebind_alloc<std::shared_ptr<T const>>>
+		{
+			using node_list = L<std::shared_ptr<T const>, typename std::allocator_traits<A>::template rebind_alloc<std::shared_ptr<T const>>>;
+
+			public:
+				/// Type holding a slot in the list, which is empty for a
+				/// empty slot.
+				using node_type = std::shared_ptr<T const>;
+				/// Type returned when releasing a slot. The node is
+				/// released after unlocking the signal mutex.
+				using released_type = node_type;
+
+				/// Create the node of a slot. This allocates, and is
+				/// therefore done without holding the signal mutex.
+				/// @param allocator   The allocator of the node.
+				/// @param slot        The slot to hold.
+				template <class U>
+				static node_type make_node( A const& allocator, U&& slot ) {
+					node_type node = std::allocate_shared<T>( allocator, std::forward<U>(slot) );
+					if( !*node ) {
+						node.reset();
+					}
+					return node;
+				}
+
+				explicit shared_slots( A const& allocator = A() ) :
+					node_list( typename std::allocator_traits<A>::template rebind_alloc<node_type>( allocator ) )
+				{}
+		};
+
+		/// Trait retrieving the slot list of a thread policy, which is
+		/// `flat_slot_list` unless the policy has a `slot_list` template.
+		template <class P, class T, class A, class = void>
+		struct slot_list_of {
+			using type = flat_slot_list<T, A>;
+		};
+		template <class P, class T, class A>
+		struct slot_list_of<P, T, A, typename void_type<typename P::template slot_list<T, A>>::type> {
+			using type = typename P::template slot_list<T, A>;
+		};
+	}
+
+	/// Thread policy sharing the slots of signals between emissions, and
+	/// otherwise behaving like the policy `P`.
+	///
+	/// Each slot is stored once, in a shared immutable node. Emissions
+	/// share a snapshot of the node pointers, which is kept until the
+	/// slots are modified, so triggering a unchanged signal doesn't copy
+	/// the slots. Unlike signals with the default slot list, emissions call
+	/// the connected slot objects themselves, so:
+	///  - A slot may be called by several threads at the same time, on the
+	///    same object. A slot with mutable state, like a `mutable` lambda,
+	///    must synchronize access to its state.
+	///  - Slots with mutable state keep it between emissions.
+	///
+	/// @tparam P   The thread policy to extend.
+	template <class P = multithread_policy>
+	struct shared_slots_policy : P
+	{
+		template <class T, class A>
+		using slot_list = detail::shared_slots<T, A, detail::shared_flat_slot_list>;
+	};
+
+	/// Thread policy storing the slots of signals in a persistent vector,
+	/// and otherwise behaving like the policy `P`.
+	///
+	/// Modifying the slots copies a few small nodes instead of the slot
+	/// list, and emissions call the slots on a immutable version of the
+	/// list, shared with the list itself. This suits signals with many
+	/// slots that are frequently connected and disconnected.
+	///
+	/// The slots are shared between emissions like with
+	/// `nod::shared_slots_policy`, so slots with mutable state must
+	/// synchronize access to it.
+	///
+	/// @tparam P   The thread policy to extend.
+	template <class P = multithread_policy>
+	struct persistent_slots_policy : P
+	{
+		template <class T, class A>
+		using slot_list = detail::shared_slots<T, A, detail::persistent_slot_list>;
+	};
+
+	/// Thread policy protecting the slots of signals with a sequence lock,
+	/// and otherwise behaving like the policy `P`.
+	///
+	/// Emissions copy the slot pointers without locking the signal mutex,
+	/// and retry if the slots were modified meanwhile. Emissions don't
+	/// write any memory shared with other threads, so emission scales with
+	/// the number of threads, while connecting and disconnecting slots
+	/// still locks the signal mutex. This suits signals that are triggered
+	/// much more often than they are modified.
+	///
+	/// Disconnected slots are destroyed once no emission can be calling
+	/// them: by the thread disconnecting them if no emission is in
+	/// progress, and otherwise by the thread of the last emission that was
+	/// in progress when they were disconnected, as it finishes. Ranges
+	/// returned by `results()` must be destroyed on the thread that created
+	/// them, and keep disconnected slots of all signals with this policy
+	/// alive while they exist. Emissions retrying a copy yield with the
+	/// `yield_thread()` of the policy `P`.
+	///
+	/// The slots are shared between emissions like with
+	/// `nod::shared_slots_policy`, so slots with mutable state must
+	/// synchronize access to it.
+	///
+	/// @tparam P   The thread policy to extend.
+	template <class P = multithread_policy>
+	struct seqlock_policy : P
+	{
+		template <class T, class A>
+		using node_list = detail::seqlock_slot_list<T, A, P>;
+		template <class T, class A>
+		using slot_list = detail::shared_slots<T, A, node_list>;
+	};
+
+	/// Signal accumulator class template.
+	///
+	/// This acts sort of as a proxy for triggering a signal and
+	/// accumulating the slot return values.
+	///
+	/// This class is not really intended to instantiate by client code.
+	/// Instances are aquired as return values of the method `accumulate()`
+	/// called on signals.
+	///
+	/// @tparam S      Type of signal. The signal_accumulator acts
+	///                as a type of proxy for a signal instance of
+	///                this type.
+	/// @tparam T      Type of initial value of the accumulate algorithm.
+	///                This type must meet the requirements of `CopyAssignable`
+	///                and `CopyConstructible`
+	/// @tparam F      Type of accumulation function.
+	/// @tparam A...   Argument types of the underlying signal type.
+	///
+	template <class S, class T, class F, class...A>
+	class signal_accumulator
+	{
+		public:
+			/// Result type when calling the accumulating function operator.
+			using result_type = typename std::result_of<F(T, typename S::slot_result_type)>::type;
+
+			/// Construct a signal_accumulator as a proxy to a given signal
+			//
+			/// @param signal   Signal instance.
+			/// @param init     Initial value of the accumulate algorithm.
+			/// @param func     Binary operation function object that will be
+			///                 applied to all slot return values.
+			///                 The signature of the function should be
+			///                 equivalent of the following:
+			///                   `R func( T1 const& a, T2 const& b )`
+			///                  - The signature does not need to have `const&`.
+			///                  - The initial value, type `T`, must be implicitly
+			///                    convertible to `R`
+			///                  - The return type `R` must be implicitly convertible
+			///                    to type `T1`.
+			///                  - The type `R` must be `CopyAssignable`.
+			///                  - The type `S::slot_result_type` (return type of
+			///                    the signals slots) must be implicitly convertible to
+			///                    type `T2`.
+			signal_accumulator( S const& signal, T init, F func ) :
+				_signal( signal ),
+				_init( init ),
+				_func( func )
+			{}
+
+			/// Function call operator.
+			///
+			/// Calling this will trigger the underlying signal and accumulate
+			/// all of the connected slots return values with the current
+			/// initial value and accumulator function.
+			///
+			/// When called, this will invoke the accumulator function will
+			/// be called for each return value of the slots. The semantics
+			/// are similar to the `std::accumulate` algorithm.
+			///
+			/// @param args   Arguments to propagate to the slots of the
+			///               underlying when triggering the signal.
+			result_type operator()( A&&... args ) const {
+				return _signal.trigger_with_accumulator( _init, _func, std::forward<A>(args)... );
+			}
+
+		private:
+
+			/// Reference to the underlying signal to proxy.
+			S const& _signal;
+			/// Initial value of the accumulate algorithm.
+			T _init;
+			/// Accumulator function.
+			F _func;
+
+	};
+
+	/// Signal in-place accumulator class template.
+	///
+	/// This acts as a proxy for triggering a signal and accumulating
+	/// the slot return values into a single value that is modified in
+	/// place, instead of being reassigned for each slot.
+	///
+	/// This class is not really intended to instantiate by client code.
+	/// Instances are aquired as return values of the method
+	/// `accumulate_in_place()` called on signals.
+	///
+	/// @tparam S      Type of signal. The signal_in_place_accumulator acts
+	///                as a type of proxy for a signal instance of
+	///                this type.
+	/// @tparam T      Type of initial value of the accumulate algorithm.
+	///                This type must meet the requirements of
+	///                `CopyConstructible`.
+	/// @tparam F      Type of accumulation function.
+	/// @tparam A...   Argument types of the underlying signal type.
+	///
+	template <class S, class T, class F, class...A>
+	class signal_in_place_accumulator
+	{
+		public:
+			/// Result type when calling the accumulating function operator.
+			using result_type = T;
+
+			/// Construct a signal_in_place_accumulator as a proxy to a given signal
+			///
+			/// @param signal   Signal instance.
+			/// @param init     Initial value of the accumulate algorithm.
+			/// @param func     Function object that will be applied to all
+			///                 slot return values. The signature of the
+			///                 function should be equivalent of the following:
+			///                   `void func( T& a, R&& b )`
+			signal_in_place_accumulator( S const& signal, T init, F func ) :
+				_signal( signal ),
+				_init( init ),
+				_func( func )
+			{}
+
+			/// Function call operator.
+			///
+			/// Calling this will trigger the underlying signal, and call the
+			/// accumulator function with a copy of the initial value and
+			/// each slot return value. The accumulated value is returned.
+			///
+			/// @param args   Arguments to propagate to the slots of the
+			///               underlying when triggering the signal.
+			result_type operator()( A const&... args ) const {
+				return _signal.trigger_with_in_place_accumulator( _init, _func, args... );
+			}
+
+		private:
+
+			/// Reference to the underlying signal to proxy.
+			S const& _signal;
+			/// Initial value of the accumulate algorithm.
+			T _init;
+			/// Accumulator function.
+			F _func;
+	};
+
+	/// Signal parallel accumulator class template, defined in
+	/// `nod/parallel.hpp`.
+	template <class S, class T, class F, class...A>
+	class signal_parallel_accumulator;
+
+	/// Signal short circuit class template.
+	///
+	/// This acts as a proxy for triggering a signal, where the slots
+	/// are called in order until one of them returns a value that
+	/// satisfies a predicate.
+	///
+	/// This class is not really intended to instantiate by client code.
+	/// Instances are aquired as return values of the method `emit_until()`
+	/// called on signals.
+	///
+	/// @tparam S      Type of signal. The signal_short_circuit acts
+	///                as a type of proxy for a signal instance of
+	///                this type.
+	/// @tparam F      Type of the predicate.
+	/// @tparam A...   Argument types of the underlying signal type.
+	///
+	template <class S, class F, class...A>
+	class signal_short_circuit
+	{
+		public:
+			/// Result type when calling the function operator.
+			using result_type = typename std::decay<typename S::slot_result_type>::type;
+
+			/// Construct a signal_short_circuit as a proxy to a given signal
+			///
+			/// @param signal     Signal instance.
+			/// @param pred       Unary predicate that is applied to the slot
+			///                   return values.
+			/// @param fallback   Value returned if no slot return value
+			///                   satisfies the predicate.
+			signal_short_circuit( S const& signal, F pred, result_type fallback ) :
+				_signal( signal ),
+				_pred( pred ),
+				_fallback( fallback )
+			{}
+
+			/// Function call operator.
+			///
+			/// Calling this will trigger the underlying signal, calling
+			/// the slots in order until a slot return value satisfies
+			/// the predicate. The remaining slots are not called.
+			///
+			/// @param args   Arguments to propagate to the slots of the
+			///               underlying when triggering the signal.
+			/// @returns      The first slot return value that satisfies
+			///               the predicate, or the fallback value if no
+			///               slot return value satisfied the predicate.
+			result_type operator()( A const&... args ) const {
+				return _signal.trigger_until( _pred, _fallback, args... );
+			}
+
+		private:
+
+			/// Reference to the underlying signal to proxy.
+			S const& _signal;
+			/// Predicate deciding when to stop.
+			F _pred;
+			/// Value to return if the predicate is never satisfied.
+			result_type _fallback;
+	};
+
+	/// Lazy range of slot return values.
+	///
+	/// The range holds a snapshot of the slots connected to a signal, and
+	/// the arguments to call them with. No slot is called until the
+	/// corresponding element of the range is dereferenced, which makes
+	/// it possible to use standard algorithms like `std::find_if` on the
+	/// slot return values while only calling as many slots as needed.
+	///
+	/// Each slot is called at most once. The return value is kept in the
+	/// range, so the range can be traversed several times, and iterators
+	/// can be dereferenced repeatedly.
+	///
+	/// This class is not really intended to instantiate by client code.
+	/// Instances are aquired as return values of the method `results()`
+	/// called on signals.
+	///
+	/// @note Arguments of reference type are stored as references, so the
+	///       referenced objects must outlive the range. Other arguments
+	///       are copied into the range.
+	///
+	/// @tparam S      Type of signal.
+	/// @tparam A...   Argument types of the underlying signal type.
+	///
+	template <class S, class...A>
+	class slot_result_range
+	{
+		public:
+			/// Type of the slot return values.
+			using value_type = typename std::decay<typename S::slot_result_type>::type;
+
+			/// Forward iterator over the slot return values.
+			///
+			/// Dereferencing the iterator calls the slot, unless it has
+			/// already been called.
+			class iterator
+			{
+				public:
+					using iterator_category = std::forward_iterator_tag;
+					using value_type = typename slot_result_range::value_type;
+					using difference_type = std::ptrdiff_t;
+					using pointer = value_type const*;
+					using reference = value_type const&;
+
+					/// Iterators are default constructible
+					iterator() :
+						_range( nullptr ),
+						_index( 0 )
+					{}
+
+					/// @returns The return value of the slot at the iterator
+					///          position, calling the slot if needed.
+					reference operator*() const {
+						return _range->result( _index );
+					}
+
+					/// @returns A pointer to the return value of the slot at
+					///          the iterator position.
+					pointer operator->() const {
+						return &_range->result( _index );
+					}
+
+					/// Advance to the next slot, without calling any slot.
+					iterator& operator++() {
+						++_index;
+						return *this;
+					}
+
+					/// Advance to the next slot, without calling any slot.
+					iterator operator++(int) {
+						iterator copy{ *this };
+						++_index;
+						return copy;
+					}
+
+					bool operator==( iterator const& other ) const {
+						return _index == other._index;
+					}
+
+					bool operator!=( iterator const& other ) const {
+						return _index != other._index;
+					}
+
+				private:
+					friend class slot_result_range;
+
+					/// Create a iterator at a given slot index.
+					iterator( slot_result_range const* range, std::size_t index ) :
+						_range( range ),
+						_index( index )
+					{}
+
+					/// The range the iterator belongs to.
+					slot_result_range const* _range;
+					/// Index of the current slot.
+					std::size_t _index;
+			};
+
+			/// Ranges are not copy constructible
+			slot_result_range( slot_result_range const& ) = delete;
+			/// Ranges are not copy assignable
+			slot_result_range& operator=( slot_result_range const& ) = delete;
+			/// Ranges are move constructible
+			slot_result_range( slot_result_range&& ) = default;
+
+			/// @returns Iterator to the first slot return value.
+			iterator begin() const {
+				return { this, 0 };
+			}
+
+			/// @returns Iterator one past the last slot return value.
+			iterator end() const {
+				return { this, _entries.size() };
+			}
+
+			/// @returns The number of slots in the range.
+			std::size_t size() const {
+				return _entries.size();
+			}
+
+			/// @returns `true` if the range contains no slots.
+			bool empty() const {
+				return _entries.empty();
+			}
+
+		private:
+			template<class, class> friend class signal_type;
+			/// A slot of the snapshot and its return value, once it has
+			/// been called.
+			struct entry {
+				explicit entry( std::size_t i ) :
+					index( i )
+				{}
+				/// The slot index of the slot.
+				std::size_t index;
+				/// The slot return value.
+				detail::lazy_value<value_type> value;
+			};
+
+			/// Create a range from a snapshot of slots.
+			/// @param instrument   The instrument of the signal, observing the
+			///                     calls made through the range.
+			/// @param slots        The slot snapshot. Empty slots are skipped.
+			/// @param allocator    The allocator of the signal.
+			/// @param args         The arguments to call the slots with.
+			slot_result_range( typename S::instrument_type& instrument, typename S::snapshot_type slots, typename S::allocator_type const& allocator, A const&... args ) :
+				_emission( instrument ),
+				_slots( std::move(slots) ),
+				_entries( allocator ),
+				_args( args... )
+			{
+				_entries.reserve( _slots.size() );
+				for( std::size_t i = 0; i < _slots.size(); ++i ) {
+					if( _slots[i] ) {
+						_entries.emplace_back( i );
+					}
+				}
+			}
+
+			/// Retrieve the return value of a slot, calling it if needed.
+			/// @param index   The index of the slot.
+			value_type const& result( std::size_t index ) const {
+				entry& e = _entries[index];
+				if( !e.value.has_value() ) {
+					e.value.emplace( call( e, typename detail::make_index_sequence<sizeof...(A)>::type{} ) );
+				}
+				return e.value.get();
+			}
+
+			/// Call a slot with the stored arguments.
+			template <std::size_t... I>
+			value_type call( entry const& e, detail::index_sequence<I...> ) const {
+				return S::invoke( _emission, e.index, *_slots[e.index], std::get<I>( _args )... );
+			}
+
+			/// The emission the slot calls are part of.
+			mutable typename S::emission_type _emission;
+			/// The slot snapshot the range was created from.
+			typename S::snapshot_type _slots;
+			/// The slots of the range and their return values.
+			mutable std::vector<entry, typename std::allocator_traits<typename S::allocator_type>::template rebind_alloc<entry>> _entries;
+			/// The arguments to call the slots with.
+			std::tuple<A...> _args;
+	};
+
+	namespace detail {
+		/// Bookkeeping shared by signals of all signatures and thread
+		/// policies.
+		///
+		/// This keeps the number of connected slots, and the lifetime of the
+		/// disconnector shared with the connections of the signal. Keeping
+		/// this out of the signal template means it is compiled once, instead
+		/// of once for every signal signature.
+		///
+		/// The signal base is itself the disconnector of the signal, and
+		/// disconnects slots through a function provided by the signal.
+		class signal_base :
+			public disconnector
+		{
+			public:
+				signal_base( signal_base const& ) = delete;
+				signal_base& operator=( signal_base const& ) = delete;
+
+				/// Disconnect a slot, called by the connections of the signal.
+				/// @param index   The slot index of the slot to disconnect.
+				void operator()( std::size_t index ) const override {
+					_disconnect( const_cast<signal_base&>( *this ), index );
+				}
+
+			protected:
+				/// Function disconnecting a slot from a signal
+				using disconnect_function = void (*)( signal_base&, std::size_t );
+
+				/// @param disconnect   Function disconnecting a slot from the
+				///                     signal deriving from this base.
+				explicit signal_base( disconnect_function disconnect ) :
+					_disconnect( disconnect ),
+					_slot_count( 0 )
+				{}
+
+				~signal_base() = default;
+
+				/// Create a connection to a slot, creating the shared
+				/// disconnector if needed.
+				/// @param index   The slot index of the connected slot.
+				connection make_connection( std::size_t index ) {
+					if( _shared_disconnector == nullptr ) {
+						_shared_disconnector = std::shared_ptr<disconnector>{ this, no_delete };
+					}
+					return connection{ _shared_disconnector, index };
+				}
+
+				/// @returns `true` if a connection is connected to this signal.
+				bool owns( connection const& c ) const {
+					return _shared_disconnector != nullptr && c._weak_disconnector.lock() == _shared_disconnector;
+				}
+
+				/// @returns The slot index of a connection.
+				static std::size_t index_of( connection const& c ) {
+					return c._index;
+				}
+
+				/// Invalidate the shared disconnector in a way that is safe
+				/// according to the thread policy of the signal.
+				///
+				/// This will effectively make all current connection objects to
+				/// to this signal incapable of disconnecting, since they keep a
+				/// weak pointer to the shared disconnector object.
+				/// @param yield_thread   Function yielding the current thread,
+				///                       provided by the thread policy.
+				NOD_NOINLINE void invalidate_disconnector( void (*yield_thread)() ) {
+					// If we are unlucky, some of the connected slots
+					// might be in the process of disconnecting from other threads.
+					// If this happens, we are risking to destruct the disconnector
+					// object managed by our shared pointer before they are done
+					// disconnecting. This would be bad. To solve this problem, we
+					// discard the shared pointer (that is pointing to the disconnector
+					// object within our own instance), but keep a weak pointer to that
+					// instance. We then stall the destruction until all other weak
+					// pointers have released their "lock" (indicated by the fact that
+					// we will get a nullptr when locking our weak pointer).
+					NOD_PROBE1( invalidate_disconnector_begin, this );
+					std::weak_ptr<disconnector> weak{_shared_disconnector};
+					_shared_disconnector.reset();
+					while( weak.lock() != nullptr )	{
+						// we just yield here, allowing the OS to reschedule. We do
+						// this until all threads has released the disconnector object.
+						yield_thread();
+					}
+					NOD_PROBE1( invalidate_disconnector_end, this );
+				}
+
+				/// Function disconnecting a slot from the derived signal
+				disconnect_function _disconnect;
+				/// Number of connected slots
+				std::size_t _slot_count;
+				/// Shared pointer to the disconnector. All connection objects has a
+				/// weak pointer to this pointer for performing disconnections.
+				std::shared_ptr<disconnector> _shared_disconnector;
+		};
+
+		/// Part of signals depending on the thread policy, but not on the
+		/// signature: the locking of the signal mutex, and the instrument
+		/// observing the signal.
+		template <class P>
+		class signal_core :
+			public signal_base
+		{
+			protected:
+				/// Thread policy currently in use
+				using thread_policy = P;
+				/// Type of mutex, provided by threading policy
+				using mutex_type = typename thread_policy::mutex_type;
+				/// Type of mutex lock, provided by threading policy
+				using mutex_lock_type = typename thread_policy::mutex_lock_type;
+				/// Lock of the signal mutex, telling the lock type which
+				/// operation is locking.
+				using operation_lock = detail::operation_lock<mutex_lock_type, mutex_type>;
+				/// Type of instrument recording the activity of the signal,
+				/// provided by the threading policy.
+				using instrument_type = typename instrument_of<thread_policy>::type;
+
+				explicit signal_core( disconnect_function disconnect ) :
+					signal_base( disconnect )
+				{}
+
+				/// @returns `true` if a connection is connected to this signal.
+				bool owns_locked( connection const& c ) const {
+					operation_lock lock{ _mutex, lock_operation::query };
+					return owns( c );
+				}
+
+				/// Invalidate the shared disconnector, yielding with the
+				/// thread policy while connections are disconnecting.
+				void invalidate() {
+					invalidate_disconnector( &thread_policy::yield_thread );
+				}
+
+				/// Bookkeeping of a connected slot, done while holding the mutex.
+				/// @param index   The slot index of the connected slot.
+				/// @param size    The size of the slot vector.
+				/// @returns       The connection to the slot.
+				connection on_connected( std::size_t index, std::size_t size ) {
+					++_slot_count;
+					_instrument.on_connect( index, _slot_count, size - _slot_count );
+					NOD_PROBE3( connect, this, index, _slot_count );
+					return make_connection( index );
+				}
+
+				/// Bookkeeping of a disconnected slot, done while holding the mutex.
+				/// @param index          The slot index of the disconnected slot.
+				/// @param disconnected   `true` if the slot was connected.
+				/// @param size           The size of the slot vector.
+				void on_disconnected( std::size_t index, bool disconnected, std::size_t size ) {
+					if( disconnected ) {
+						--_slot_count;
+					}
+					_instrument.on_disconnect( disconnected ? 1 : 0, _slot_count, size - _slot_count );
+					NOD_PROBE3( disconnect, this, index, _slot_count );
+				}
+
+				/// Bookkeeping of disconnecting all slots, done while holding
+				/// the mutex.
+				void on_disconnected_all() {
+					_instrument.on_disconnect( _slot_count, 0, 0 );
+					_slot_count = 0;
+					invalidate();
+				}
+
+				/// Mutex to synchronize access to the slot vector
+				mutable mutex_type _mutex;
+				/// Instrument recording the activity of the signal
+				mutable instrument_type _instrument;
+		};
+	} // namespace detail
+
+	/// Signal template specialization.
+	///
+	/// This is the main signal implementation, and it is used to
+	/// implement the observer pattern whithout the overhead
+	/// boilerplate code that typically comes with it.
+	///
+	/// Any function or function object is considered a slot, and
+	/// can be connected to a signal instance, as long as the signature
+	/// of the slot matches the signature of the signal.
+	///
+	/// @tparam P      Threading policy for the signal.
+	///                A threading policy must provide two type definitions:
+	///                 - P::mutex_type, this type will be used as a mutex
+	///                   in the signal_type class template.
+	///                 - P::mutex_lock_type, this type must implement a
+	///                   constructor that takes a P::mutex_type as a parameter,
+	///                   or a P::mutex_type and the nod::lock_operation that
+	///                   is locking, and it must have the semantics of a scoped mutex lock
+	///                   like std::lock_guard, i.e. locking in the constructor
+	///                   and unlocking in the destructor.
+	///
+	/// @tparam R      Return value type of the slots connected to the signal.
+	/// @tparam A...   Argument types of the slots connected to the signal.
+	template <class P, class R, class... A >
+	class signal_type<P,R(A...)> :
+		private detail::signal_core<P>
+	{
+		public:
+			/// signals are not copy constructible
+			signal_type( signal_type const& ) = delete;
+			/// signals are not copy assignable
+			signal_type& operator=( signal_type const& ) = delete;
+
+			/// signals are default constructible
+			signal_type() :
+				core_type( &signal_type::disconnect_slot )
+			{}
+
+			/// Construct a named signal.
+			///
+			/// The name is passed on to the instrument of the thread policy,
+			/// and is used by instruments that identify signals, like the
+			/// one of `nod::tracing_policy`. Other signals ignore the name.
+			/// @param name   The name of the signal.
+			explicit signal_type( char const* name ) :
+				core_type( &signal_type::disconnect_slot )
+			{
+				_instrument.set_name( name );
+			}
+
+			// Destruct the signal object.
+			~signal_type() {
+				this->invalidate();
+			}
+
+			/// Type that will be used to store the slots for this signal type.
+			using slot_type = std::function<R(A...)>;
+			/// Return type of the slots.
+			using slot_result_type = R;
+			/// Allocator of the slot storage and the slot snapshots, which is
+			/// the allocator of the thread policy, if it has one.
+			using allocator_type = detail::rebind_allocator<P, slot_type>;
+			/// Type that is used for counting the slots connected to this signal.
+			using size_type = std::size_t;
+
+			/// Construct a signal allocating its slot storage and the slot
+			/// snapshots taken when it's triggered with a given allocator.
+			/// @param allocator   The allocator to use.
+			explicit signal_type( allocator_type const& allocator ) :
+				core_type( &signal_type::disconnect_slot ),
+				_slots( allocator )
+			{}
+
+			/// Construct a named signal with a given allocator.
+			/// @param name        The name of the signal.
+			/// @param allocator   The allocator to use.
+			signal_type( char const* name, allocator_type const& allocator ) :
+				core_type( &signal_type::disconnect_slot ),
+				_slots( allocator )
+			{
+				_instrument.set_name( name );
+			}
+
+			/// @returns The allocator of the signal.
+			allocator_type get_allocator() const {
+				return allocator_type( _slots.get_allocator() );
+			}
+
+
+			/// Connect a new slot to the signal.
+			///
+			/// The connected slot will be called every time the signal
+			/// is triggered.
+			/// @param slot   The slot to connect. This must be a callable with
+			///               the same signature as the signal itself.
+			/// @return       A connection object is returned, and can be used to
+			///               disconnect the slot.
+			template <class T>
+			connection connect( T&& slot ) {
+				// Slot lists storing slots in nodes create the node before
+				// locking, and only move it into the list under the lock.
+				auto&& node = slot_list::make_node( get_allocator(), std::forward<T>(slot) );
+				snapshot_type stale;
+				operation_lock lock{ _mutex, lock_operation::connect };
+				_slots.push_back( std::forward<decltype(node)>(node), stale );
+				return this->on_connected( _slots.size()-1, _slots.size() );
+			}
+
+			/// Function call operator.
+			///
+			/// Calling this is how the signal is triggered and the
+			/// connected slots are called.
+			///
+			/// @note The slots will be called in the order they were
+			///       connected to the signal.
+			///
+			/// @param args   Arguments that will be propagated to the
+			///               connected slots when they are called.
+			void operator()( A const&... args ) const {
+				NOD_PROBE1( emit_begin, this );
+				emission_type emission{ _instrument };
+				auto slots = snapshot_slots();
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						invoke( emission, i, *slots[i], args... );
+					}
+				}
+				NOD_PROBE2( emit_end, this, slots.size() );
+			}
+
+			/// Construct a accumulator proxy object for the signal.
+			///
+			/// The intended purpose of this function is to create a function
+			/// object that can be used to trigger the signal and accumulate
+			/// all the slot return values.
+			///
+			/// The algorithm used to accumulate slot return values is similar
+			/// to `std::accumulate`. A given binary function is called for
+			/// each return value with the parameters consisting of the
+			/// return value of the accumulator function applied to the
+			/// previous slots return value, and the current slots return value.
+			/// A initial value must be provided for the first slot return type.
+			///
+			/// @note This can only be used on signals that have slots with
+			///       non-void return types, since we can't accumulate void
+			///       values.
+			///
+			/// @tparam T      The type of the initial value given to the accumulator.
+			/// @tparam F      The accumulator function type.
+			/// @param init    Initial value given to the accumulator.
+			/// @param op      Binary operator function object to apply by the accumulator.
+			///                The signature of the function should be
+			///                equivalent of the following:
+			///                  `R func( T1 const& a, T2 const& b )`
+			///                 - The signature does not need to have `const&`.
+			///                 - The initial value, type `T`, must be implicitly
+			///                   convertible to `R`
+			///                 - The return type `R` must be implicitly convertible
+			///                   to type `T1`.
+			///                 - The type `R` must be `CopyAssignable`.
+			///                 - The type `S::slot_result_type` (return type of
+			///                   the signals slots) must be implicitly convertible to
+			///                   type `T2`.
+			///                 - If `T1` is taken by value, the accumulated value is
+			///                   moved into the function instead of being copied.
+			template <class T, class F>
+			signal_accumulator<signal_type, T, F, A...> accumulate( T init, F op ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to accumulate slot return values with 'void' as return type." );
+				return { *this, init, op };
+			}
+
+			/// Construct a in-place accumulator proxy object for the signal.
+			///
+			/// This works like `accumulate()`, but the accumulator function
+			/// modifies the accumulated value through a reference instead of
+			/// returning a new value. No copies of the accumulated value are
+			/// made while triggering the signal, which makes this the
+			/// preferred way of accumulating into containers or other large
+			/// objects.
+			///
+			/// @note This can only be used on signals that have slots with
+			///       non-void return types, since we can't accumulate void
+			///       values.
+			///
+			/// @tparam T      The type of the initial value and the result.
+			/// @tparam F      The accumulator function type.
+			/// @param init    Initial value given to the accumulator.
+			/// @param op      Function object to apply by the accumulator.
+			///                The signature of the function should be
+			///                equivalent of the following:
+			///                  `void func( T& a, R&& b )`
+			///                 - The return value of the function is ignored.
+			///                 - The slot return value may be taken by value
+			///                   or `const&` as well.
+			template <class T, class F>
+			signal_in_place_accumulator<signal_type, T, F, A...> accumulate_in_place( T init, F op ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to accumulate slot return values with 'void' as return type." );
+				return { *this, init, op };
+			}
+
+			/// Construct a parallel accumulator proxy object for the signal.
+			///
+			/// This works like `accumulate()`, but the slots are divided into
+			/// contiguous chunks that are called from separate worker threads.
+			/// Each worker reduces the return values of its own chunk, and the
+			/// partial results are then combined pairwise in a tree. Finally
+			/// the initial value is combined with the reduced value as
+			/// `op( init, reduced )`.
+			///
+			/// The chunks are called by the triggering thread and the threads
+			/// of a pool shared by all signals, which is started the first
+			/// time it's used. The slots are instead accumulated on the
+			/// triggering thread if the hardware supports a single thread,
+			/// `max_workers` is 1, or there are too few slots to give each
+			/// thread `min_slots_per_worker` slots.
+			///
+			/// The returned proxy and the thread pool are defined in
+			/// `nod/parallel.hpp`, which must be included to trigger the
+			/// signal through the proxy.
+			///
+			/// @note The operation must be associative, since the grouping of
+			///       the slot return values is unspecified. The order of the
+			///       operands is preserved though, so the operation does not
+			///       need to be commutative.
+			/// @note The slots are called concurrently, and must therefore be
+			///       safe to call from several threads at the same time. The
+			///       order in which slots are called is unspecified.
+			///
+			/// @tparam T            The type of the initial value and the result.
+			/// @tparam F            The reduction function type.
+			/// @param init          Initial value given to the reduction.
+			/// @param op            Associative binary operator function object.
+			///                      The signature of the function should be
+			///                      equivalent of `T func( T const& a, T const& b )`,
+			///                      and the slot return type must be implicitly
+			///                      convertible to `T`.
+			/// @param max_workers   Maximum number of threads used to call the slots,
+			///                      including the triggering thread. The default
+			///                      value `0` means that the number of concurrent
+			///                      threads supported by the hardware is used.
+			/// @param min_slots_per_worker   Minimum number of slots called by
+			///                      each thread. Signals with fewer slots than
+			///                      twice this number are accumulated on the
+			///                      triggering thread, like with `accumulate()`.
+			///                      The default suits slots returning within
+			///                      nanoseconds. Slots taking microseconds or
+			///                      more should be given a lower minimum, like
+			///                      16, or a few hundred of them will never be
+			///                      called in parallel.
+			template <class T, class F>
+			signal_parallel_accumulator<signal_type, T, F, A...> accumulate_parallel( T init, F op, std::size_t max_workers = 0, std::size_t min_slots_per_worker = default_min_slots_per_worker ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to accumulate slot return values with 'void' as return type." );
+				return { *this, init, op, max_workers, min_slots_per_worker };
+			}
+
+			/// Default minimum number of slots called by each thread of a
+			/// parallel accumulation. Below this, handing the slots over to
+			/// a worker thread costs more than calling cheap slots.
+			static constexpr std::size_t default_min_slots_per_worker = 2048;
+
+
+			/// Construct a short circuiting proxy object for the signal.
+			///
+			/// Triggering the signal through the returned proxy calls the
+			/// slots in the order they were connected, until a slot returns
+			/// a value that satisfies the given predicate. No further slots
+			/// are called after that, and the satisfying value is returned.
+			///
+			/// This can be used to find the first slot that handles an
+			/// event, or to stop at the first slot reporting an error.
+			///
+			/// @note This can only be used on signals that have slots with
+			///       non-void return types.
+			///
+			/// @tparam F         The predicate type.
+			/// @tparam T         The type of the fallback value. This type must
+			///                   be implicitly convertible to the slot return type.
+			/// @param pred       Unary predicate called with each slot return
+			///                   value. The signature of the predicate should
+			///                   be equivalent of `bool pred( R const& value )`.
+			/// @param fallback   Value returned when no slot return value
+			///                   satisfies the predicate, which is also the
+			///                   case when no slots are connected.
+			template <class F, class T = typename std::decay<R>::type>
+			signal_short_circuit<signal_type, F, A...> emit_until( F pred, T fallback = T{} ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to inspect slot return values with 'void' as return type." );
+				return { *this, pred, fallback };
+			}
 
 			/// Trigger the signal, calling the slots and aggregate all
 			/// the slot return values into a container.
 			///
 			/// @tparam C     The type of container. This type must be
-			///               `DefaultConstructible`, and usable with
-			///               `std::back_insert_iterator`. Additionally it
+			///               `DefaultConstructible`, and either usable with
+			///               `std::back_insert_iterator` or a fixed size
+			///               container like `std::array`. Additionally it
 			///               must be either copyable or moveable.
 			/// @param args   The arguments to propagate to the slots.
 			template <class C>
 			C aggregate( A const&... args ) const {
 				static_assert( std::is_same<R,void>::value == false, "Unable to aggregate slot return values with 'void' as return type." );
+				NOD_PROBE1( aggregate_begin, this );
 				C container;
-				auto iterator = std::back_inserter( container );
-				for( auto const& slot : copy_slots() ) {
-					if( slot ) {
-						(*iterator) = slot( args... );
+				aggregate_into( container, args... );
+				NOD_PROBE1( aggregate_end, this );
+				return container;
+			}
+
+			/// Trigger the signal, calling the slots and aggregate all
+			/// the slot return values into an existing container.
+			///
+			/// Containers that can grow are cleared first, and capacity is
+			/// reserved for all slots before any slot is called. Since the
+			/// capacity of the container is kept between calls, the same
+			/// container can be reused for every trigger of the signal
+			/// without allocating.
+			///
+			/// Fixed size containers, like `std::array`, are filled from the
+			/// beginning. If there are more slots than elements in the
+			/// container, all slots are still called but the surplus return
+			/// values are discarded.
+			///
+			/// @tparam C          The type of container. This type must either
+			///                    support `clear()` and `std::back_insert_iterator`,
+			///                    or support `std::begin()` and `std::end()`.
+			/// @param container   The container to aggregate into.
+			/// @param args        The arguments to propagate to the slots.
+			/// @returns           The number of slot return values stored in
+			///                    the container.
+			template <class C>
+			typename std::enable_if<!detail::is_iterator<C>::value, std::size_t>::type aggregate_into( C& container, A const&... args ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to aggregate slot return values with 'void' as return type." );
+				return aggregate_into_container( container, detail::is_back_insertable<C>{}, args... );
+			}
+
+			/// Trigger the signal, calling the slots and writing all the
+			/// slot return values to an output iterator.
+			///
+			/// @tparam O       The type of output iterator.
+			/// @param output   The output iterator to write the slot return
+			///                 values to.
+			/// @param args     The arguments to propagate to the slots.
+			/// @returns        The output iterator one past the last written
+			///                 slot return value.
+			template <class O>
+			typename std::enable_if<detail::is_iterator<O>::value, O>::type aggregate_into( O output, A const&... args ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to aggregate slot return values with 'void' as return type." );
+				emission_type emission{ _instrument };
+				auto slots = snapshot_slots();
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						*output = invoke( emission, i, *slots[i], args... );
+						++output;
 					}
 				}
-				return container;
+				return output;
+			}
+
+			/// Trigger the signal, calling the slots and writing the slot
+			/// return values to a range with fixed capacity.
+			///
+			/// All slots are called, but only as many return values as fits
+			/// in the range are stored. The surplus return values are discarded.
+			///
+			/// @tparam I      The type of forward iterator.
+			/// @param first   The beginning of the range to write to.
+			/// @param last    The end of the range to write to.
+			/// @param args    The arguments to propagate to the slots.
+			/// @returns       The iterator one past the last written slot
+			///                return value.
+			template <class I>
+			I aggregate_into( I first, I last, A const&... args ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to aggregate slot return values with 'void' as return type." );
+				emission_type emission{ _instrument };
+				auto slots = snapshot_slots();
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						if( first != last ) {
+							*first = invoke( emission, i, *slots[i], args... );
+							++first;
+						}
+						else {
+							invoke( emission, i, *slots[i], args... );
+						}
+					}
+				}
+				return first;
+			}
+
+			/// Trigger the signal lazily, returning a range of the slot
+			/// return values.
+			///
+			/// A snapshot of the currently connected slots is taken, but no
+			/// slot is called until its return value is accessed through the
+			/// range. This allows the slot return values to be processed with
+			/// standard algorithms, without materializing a container and
+			/// without calling more slots than needed. For example,
+			/// `std::find_if` only calls the slots up to the first match.
+			///
+			/// @note This can only be used on signals that have slots with
+			///       non-void return types.
+			///
+			/// @param args   The arguments to propagate to the slots. Arguments
+			///               of reference type must outlive the returned range.
+			/// @returns      A range of the slot return values.
+			template <class T = R>
+			slot_result_range<signal_type, A...> results( A const&... args ) const {
+				static_assert( std::is_same<T,void>::value == false, "Unable to iterate slot return values with 'void' as return type." );
+				return { _instrument, snapshot_slots(), get_allocator(), args... };
 			}
 
 			/// Count the number of slots connected to this signal
@@ -462,71 +3009,217 @@ namespace nod {
 			/// Disconnects all slots
 			/// @note This operation invalidates all scoped_connection objects
 			void disconnect_all_slots() {
-				mutex_lock_type lock{ _mutex };
-				_slots.clear();
-				_slot_count = 0;
-				invalidate_disconnector();
+				slot_list released{ _slots.get_allocator() };
+				operation_lock lock{ _mutex, lock_operation::disconnect_all };
+				_slots.swap( released );
+				this->on_disconnected_all();
+			}
+
+			/// Retrieve the runtime statistics of the signal.
+			///
+			/// This is only available for signals with a thread policy that
+			/// provides a instrument recording statistics, like
+			/// `nod::statistics_policy` from `nod/instrument/statistics.hpp`.
+			///
+			/// @returns   A snapshot of the statistics recorded by the instrument.
+			template <class I = typename detail::instrument_of<P>::type>
+			typename I::statistics_type stats() const {
+				return _instrument.stats();
+			}
+
+			/// Retrieve the lock statistics of the signal mutex.
+			///
+			/// This is only available for signals with a thread policy that
+			/// provides a mutex recording lock statistics, like
+			/// `nod::lock_contention_policy` from
+			/// `nod/instrument/lock_contention.hpp`.
+			///
+			/// @returns   A snapshot of the statistics recorded by the mutex.
+			template <class M = typename P::mutex_type>
+			decltype( std::declval<M const&>().stats() ) lock_stats() const {
+				return _mutex.stats();
+			}
+
+			/// Retrieve the sampled slot timings of the signal.
+			///
+			/// This is only available for signals with a thread policy that
+			/// provides a instrument recording slot timings, like
+			/// `nod::profiling_policy` from `nod/instrument/profiling.hpp`.
+			///
+			/// @returns   A report of the slot timings recorded by the instrument.
+			template <class I = typename detail::instrument_of<P>::type>
+			typename I::profile_type profile() const {
+				return _instrument.profile();
+			}
+
+			/// Retrieve the sampled timings of a single slot.
+			///
+			/// @see profile()
+			/// @param c   Connection of the slot.
+			/// @returns   The slot timings, which are empty if the connection
+			///            is not connected to this signal.
+			template <class I = typename detail::instrument_of<P>::type>
+			typename I::slot_profile_type profile( connection const& c ) const {
+				return this->owns_locked( c ) ? _instrument.profile( c._index ) : typename I::slot_profile_type{};
+			}
+
+			/// Label a slot, to make it identifiable in the profile of the signal.
+			///
+			/// @see profile()
+			/// @param c       Connection of the slot to label. Nothing happens
+			///                if the connection is not connected to this signal.
+			/// @param label   The label of the slot.
+			template <class I = typename detail::instrument_of<P>::type>
+			void label_slot( connection const& c, typename I::label_type label ) {
+				if( this->owns_locked( c ) ) {
+					_instrument.label( c._index, std::move(label) );
+				}
 			}
 
 		private:
 			template<class, class, class, class...> friend class signal_accumulator;
+			template<class, class, class, class...> friend class signal_in_place_accumulator;
+			template<class, class, class, class...> friend class signal_parallel_accumulator;
+			template<class, class, class...> friend class signal_short_circuit;
+			template<class, class...> friend class slot_result_range;
+			/// Signature independent part of the signal
+			using core_type = detail::signal_core<P>;
 			/// Thread policy currently in use
 			using thread_policy = P;
-			/// Type of mutex, provided by threading policy
-			using mutex_type = typename thread_policy::mutex_type;
-			/// Type of mutex lock, provided by threading policy
-			using mutex_lock_type = typename thread_policy::mutex_lock_type;
-
-			/// Invalidate the internal disconnector object in a way
-			/// that is safe according to the current thread policy.
-			///
-			/// This will effectively make all current connection objects to
-			/// to this signal incapable of disconnecting, since they keep a
-			/// weak pointer to the shared disconnector object.
-			void invalidate_disconnector() {
-				// If we are unlucky, some of the connected slots
-				// might be in the process of disconnecting from other threads.
-				// If this happens, we are risking to destruct the disconnector
-				// object managed by our shared pointer before they are done
-				// disconnecting. This would be bad. To solve this problem, we
-				// discard the shared pointer (that is pointing to the disconnector
-				// object within our own instance), but keep a weak pointer to that
-				// instance. We then stall the destruction until all other weak
-				// pointers have released their "lock" (indicated by the fact that
-				// we will get a nullptr when locking our weak pointer).
-				std::weak_ptr<detail::disconnector> weak{_shared_disconnector};
-				_shared_disconnector.reset();
-				while( weak.lock() != nullptr )	{
-					// we just yield here, allowing the OS to reschedule. We do
-					// this until all threads has released the disconnector object.
-					thread_policy::yield_thread();
-				}
-			}
-
-			/// Retrieve a copy of the current slots
+			/// List of slots, provided by the thread policy
+			using slot_list = typename detail::slot_list_of<P, slot_type, allocator_type>::type;
+			/// Type returned by the slot list when releasing a slot
+			using released_type = typename slot_list::released_type;
+			/// Immutable snapshot of the slots
+			using snapshot_type = typename slot_list::snapshot_type;
+			/// Lock of the signal mutex, provided by the core.
+			using operation_lock = typename core_type::operation_lock;
+			/// Type of instrument recording the activity of the signal,
+			/// provided by the threading policy.
+			using instrument_type = typename core_type::instrument_type;
+			/// Type of the scope of a single emission, provided by the instrument.
+			using emission_type = typename instrument_type::emission;
+
+			/// Call a slot as part of a emission, letting the instrument
+			/// observe the call.
+			/// @param emission   The emission the call is part of.
+			/// @param index      The slot index of the slot.
+			/// @param slot       The slot to call.
+			/// @param args       The arguments to propagate to the slot.
+			static R invoke( emission_type& emission, std::size_t index, slot_type const& slot, A const&... args ) {
+				detail::slot_scope<emission_type> scope{ emission, index };
+				return slot( args... );
+			}
+
+			using core_type::_mutex;
+			using core_type::_instrument;
+			using core_type::_slot_count;
+
+			/// Retrieve a snapshot of the current slots
 			///
 			/// It's useful and necessary to copy the slots so we don't need
 			/// to hold the lock while calling the slots. If we hold the lock
 			/// we prevent the called slots from modifying the slots vector.
 			/// This simple "double buffering" will allow slots to disconnect
 			/// themself or other slots and connect new slots.
-			std::vector<slot_type> copy_slots() const
+			///
+			/// How the slots are copied depends on the slot list. The default
+			/// list copies the slots into a buffer reused by the following
+			/// emissions of the thread, while the lists of policies like
+			/// `nod::shared_slots_policy` share the slots themselves.
+			snapshot_type snapshot_slots() const
+			{
+				return snapshot_slots( std::integral_constant<bool, slot_list::lock_free_snapshots>{} );
+			}
+
+			/// Take a snapshot while holding the signal mutex.
+			snapshot_type snapshot_slots( std::false_type ) const
+			{
+				operation_lock lock{ _mutex, lock_operation::emit };
+				return _slots.snapshot();
+			}
+
+			/// Take a snapshot from a slot list that synchronizes itself
+			/// with the modifications of the slots.
+			snapshot_type snapshot_slots( std::true_type ) const
 			{
-				mutex_lock_type lock{ _mutex };
-				return _slots;
+				return _slots.snapshot();
 			}
 
 			/// Implementation of the signal accumulator function call
 			template <class T, class F>
 			typename signal_accumulator<signal_type, T, F, A...>::result_type trigger_with_accumulator( T value, F& func, A const&... args ) const {
-				for( auto const& slot : copy_slots() ) {
-					if( slot ) {
-						value = func( value, slot( args... ) );
+				emission_type emission{ _instrument };
+				auto slots = snapshot_slots();
+				return accumulate_slots( emission, slots, std::move(value), func, args... );
+			}
+
+			/// Accumulate the return values of the slots in a snapshot, in
+			/// order, on the calling thread.
+			template <class T, class F>
+			T accumulate_slots( emission_type& emission, snapshot_type const& slots, T value, F& func, A const&... args ) const {
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						value = func( std::move(value), invoke( emission, i, *slots[i], args... ) );
 					}
 				}
 				return value;
 			}
 
+			/// Implementation of the signal in-place accumulator function call
+			template <class T, class F>
+			T trigger_with_in_place_accumulator( T value, F& func, A const&... args ) const {
+				emission_type emission{ _instrument };
+				auto slots = snapshot_slots();
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						func( value, invoke( emission, i, *slots[i], args... ) );
+					}
+				}
+				return value;
+			}
+
+			/// Implementation of aggregation into containers that can grow.
+			template <class C>
+			std::size_t aggregate_into_container( C& container, std::true_type, A const&... args ) const {
+				container.clear();
+				emission_type emission{ _instrument };
+				auto slots = snapshot_slots();
+				detail::reserve( container, slots.size(), 0 );
+				auto iterator = std::back_inserter( container );
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						(*iterator) = invoke( emission, i, *slots[i], args... );
+					}
+				}
+				return container.size();
+			}
+
+			/// Implementation of aggregation into fixed size containers.
+			template <class C>
+			std::size_t aggregate_into_container( C& container, std::false_type, A const&... args ) const {
+				using std::begin;
+				using std::end;
+				auto first = begin( container );
+				return static_cast<std::size_t>( std::distance( first, aggregate_into( first, end( container ), args... ) ) );
+			}
+
+			/// Implementation of the signal short circuit function call
+			template <class F, class T>
+			T trigger_until( F const& pred, T const& fallback, A const&... args ) const {
+				emission_type emission{ _instrument };
+				auto slots = snapshot_slots();
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						T value = invoke( emission, i, *slots[i], args... );
+						if( pred( value ) ) {
+							return value;
+						}
+					}
+				}
+				return fallback;
+			}
+
 			/// Implementation of the disconnection operation.
 			///
 			/// This is private, and only called by the connection
@@ -534,64 +3227,22 @@ namespace nod {
 			/// @param index   The slot index of the slot that should
 			///                be disconnected.
 			void disconnect( std::size_t index ) {
-				mutex_lock_type lock( _mutex );
+				released_type released{};
+				snapshot_type stale;
+				operation_lock lock{ _mutex, lock_operation::disconnect };
 				assert( _slots.size() > index );
-				if( _slots[ index ] != nullptr ) {
-					--_slot_count;
-				}
-				_slots[ index ] = slot_type{};
-				while( _slots.size()>0 && !_slots.back() ) {
-					_slots.pop_back();
-				}
+				released = _slots.release( index, stale );
+				this->on_disconnected( index, static_cast<bool>( released ), _slots.size() );
 			}
 
-			/// Implementation of the shared disconnection state
-			/// used by all connection created by signal instances.
-			///
-			/// This inherits the @ref detail::disconnector interface
-			/// for type erasure.
-			struct disconnector :
-				detail::disconnector
-			{
-				/// Default constructor, resulting in a no-op disconnector.
-				disconnector() :
-					_ptr(nullptr)
-				{}
-
-				/// Create a disconnector that works with a given signal instance.
-				/// @param ptr   Pointer to the signal instance that the disconnector
-				///              should work with.
-				disconnector( signal_type<P,R(A...)>* ptr ) :
-					_ptr( ptr )
-				{}
-
-				/// Disconnect a given slot on the current signal instance.
-				/// @note If the instance is default constructed, or created
-				///       with `nullptr` as signal pointer this operation will
-				///       effectively be a no-op.
-				/// @param index   The index of the slot to disconnect.
-				void operator()( std::size_t index ) const override {
-					if( _ptr ) {
-						_ptr->disconnect( index );
-					}
-				}
-
-				/// Pointer to the current signal.
-				signal_type<P,R(A...)>* _ptr;
-			};
+			/// Disconnect a slot from a signal, called through the shared
+			/// disconnector of the signal base.
+			static void disconnect_slot( detail::signal_base& base, std::size_t index ) {
+				static_cast<signal_type&>( base ).disconnect( index );
+			}
 
-			/// Mutex to synchronize access to the slot vector
-			mutable mutex_type _mutex;
-			/// Vector of all connected slots
-			std::vector<slot_type> _slots;
-			/// Number of connected slots
-			size_type _slot_count;
-			/// Disconnector operation, used for executing disconnection in a
-			/// type erased manner.
-			disconnector _disconnector;
-			/// Shared pointer to the disconnector. All connection objects has a
-			/// weak pointer to this pointer for performing disconnections.
-			std::shared_ptr<detail::disconnector> _shared_disconnector;
+			/// List of all connected slots
+			slot_list _slots;
 	};
 
 	// Implementation of the disconnect operation of the connection class
@@ -603,22 +3254,365 @@ namespace nod {
 		_weak_disconnector.reset();
 	}
 
-	/// Signal type that is safe to use in multithreaded environments,
-	/// where the signal and slots exists in different threads.
-	/// The multithreaded policy provides mutexes and locks to synchronize
-	/// access to the signals internals.
+	/// Homogeneous signal template specialization.
+	///
+	/// This is a signal for slots that all have the same concrete type
+	/// `F`, like a single handler class. The slots are stored by value in a
+	/// contiguous array instead of being type erased by `std::function`, so
+	/// triggering the signal is a loop calling `F` directly, that the
+	/// compiler can inline and optimize as a whole.
+	///
+	/// Like other signals, the slots are called on the slots connected when
+	/// the signal was triggered, and slots can connect and disconnect slots
+	/// while they are called. Emissions call the connected slot objects
+	/// themselves, like `nod::signal_type` does, so changes made to the
+	/// state of a slot while it is called are kept.
+	///
+	/// Thread safe signals share the array of slots between the emissions,
+	/// so emissions don't allocate or copy slots, and slots called by
+	/// concurrent emissions must be safe to call concurrently. Connecting or
+	/// disconnecting a slot while the signal is triggered copies the array,
+	/// and a emission in progress keeps calling the slots of the old array.
+	/// Signals with `nod::singlethread_policy` call the slots in their
+	/// storage directly, so a slot disconnected while the signal is
+	/// triggered is no longer called by the emission in progress.
 	///
-	/// This is the recommended signal type, even for single threaded
-	/// environments.
-	template <class T> using signal = signal_type<multithread_policy, T>;
+	/// @tparam P      Threading policy for the signal, see `nod::signal_type`.
+	/// @tparam F      Type of the slots. This must be copy constructible,
+	///                and callable with the arguments of the signal.
+	/// @tparam R      Return value type of the slots connected to the signal.
+	/// @tparam A...   Argument types of the slots connected to the signal.
+	template <class P, class F, class R, class... A>
+	class homogeneous_signal_type<P,F,R(A...)> :
+		private detail::signal_core<P>
+	{
+		public:
+			/// signals are not copy constructible
+			homogeneous_signal_type( homogeneous_signal_type const& ) = delete;
+			/// signals are not copy assignable
+			homogeneous_signal_type& operator=( homogeneous_signal_type const& ) = delete;
+
+			/// signals are default constructible
+			homogeneous_signal_type() :
+				core_type( &homogeneous_signal_type::disconnect_slot )
+			{}
+
+			/// Construct a named signal, see `nod::signal_type`.
+			/// @param name   The name of the signal.
+			explicit homogeneous_signal_type( char const* name ) :
+				core_type( &homogeneous_signal_type::disconnect_slot )
+			{
+				_instrument.set_name( name );
+			}
 
-	/// Signal type that is unsafe in multithreaded environments.
-	/// No synchronizations are provided to the signal_type for accessing
-	/// the internals.
+			// Destruct the signal object.
+			~homogeneous_signal_type() {
+				this->invalidate();
+			}
+
+			/// Type of the slots of this signal type.
+			using slot_type = F;
+			/// Return type of the slots.
+			using slot_result_type = R;
+			/// Allocator of the slot storage, which is the allocator of the
+			/// thread policy, if it has one.
+			using allocator_type = detail::rebind_allocator<P, slot_type>;
+			/// Type that is used for counting the slots connected to this signal.
+			using size_type = std::size_t;
+
+			/// Construct a signal allocating its slot storage with a given
+			/// allocator.
+			/// @param allocator   The allocator to use.
+			explicit homogeneous_signal_type( allocator_type const& allocator ) :
+				core_type( &homogeneous_signal_type::disconnect_slot ),
+				_slots( entry_allocator( allocator ) )
+			{}
+
+			/// Construct a named signal with a given allocator.
+			/// @param name        The name of the signal.
+			/// @param allocator   The allocator to use.
+			homogeneous_signal_type( char const* name, allocator_type const& allocator ) :
+				core_type( &homogeneous_signal_type::disconnect_slot ),
+				_slots( entry_allocator( allocator ) )
+			{
+				_instrument.set_name( name );
+			}
+
+			/// @returns The allocator of the signal.
+			allocator_type get_allocator() const {
+				return allocator_type( _slots.get_allocator() );
+			}
+
+			/// Connect a new slot to the signal.
+			/// @param slot   The slot to connect, or a value `F` can be
+			///               constructed from.
+			/// @return       A connection object is returned, and can be used to
+			///               disconnect the slot.
+			template <class T>
+			connection connect( T&& slot ) {
+				entry added{ F( std::forward<T>(slot) ), true };
+				stale_type stale;
+				operation_lock lock{ _mutex, lock_operation::connect };
+				auto const index = _slots.push_back( std::move(added), stale );
+				return this->on_connected( index, _slots.size() );
+			}
+
+			/// Function call operator, triggering the signal.
+			///
+			/// @note The slots will be called in the order they were
+			///       connected to the signal.
+			///
+			/// @param args   Arguments that will be propagated to the
+			///               connected slots when they are called.
+			void operator()( A const&... args ) const {
+				emission_type emission{ _instrument };
+				auto slots = view_slots();
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					auto& current = slots[i];
+					if( current.connected ) {
+						invoke( emission, i, current.slot, args... );
+					}
+				}
+			}
+
+			/// Construct a accumulator proxy object for the signal, see
+			/// `nod::signal_type::accumulate`.
+			template <class T, class Op>
+			signal_accumulator<homogeneous_signal_type, T, Op, A...> accumulate( T init, Op op ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to accumulate slot return values with 'void' as return type." );
+				return { *this, init, op };
+			}
+
+			/// Trigger the signal, calling the slots and aggregate all
+			/// the slot return values into a container.
+			/// @tparam C     The type of container, which must be default
+			///               constructible and have a `push_back` method.
+			/// @param args   The arguments to propagate to the slots.
+			template <class C>
+			C aggregate( A const&... args ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to aggregate slot return values with 'void' as return type." );
+				emission_type emission{ _instrument };
+				auto slots = view_slots();
+				C container;
+				detail::reserve( container, slots.size(), 0 );
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					auto& current = slots[i];
+					if( current.connected ) {
+						container.push_back( invoke( emission, i, current.slot, args... ) );
+					}
+				}
+				return container;
+			}
+
+			/// Count the number of slots connected to this signal
+			/// @returns   The number of connected slots
+			size_type slot_count() const {
+				return _slot_count;
+			}
+
+			/// Determine if the signal is empty, i.e. no slots are connected
+			/// to it.
+			bool empty() const {
+				return slot_count() == 0;
+			}
+
+			/// Disconnects all slots
+			/// @note This operation invalidates all scoped_connection objects
+			void disconnect_all_slots() {
+				stale_type stale;
+				operation_lock lock{ _mutex, lock_operation::disconnect_all };
+				_slots.clear( stale );
+				this->on_disconnected_all();
+			}
+
+		private:
+			template<class, class, class, class...> friend class signal_accumulator;
+			/// Signature independent part of the signal
+			using core_type = detail::signal_core<P>;
+			/// Lock of the signal mutex, provided by the core.
+			using operation_lock = typename core_type::operation_lock;
+			/// Type of the scope of a single emission, provided by the instrument.
+			using emission_type = typename core_type::instrument_type::emission;
+
+			using core_type::_mutex;
+			using core_type::_instrument;
+			using core_type::_slot_count;
+
+			/// A slot, and whether it is still connected
+			struct entry {
+				F slot;
+				bool connected;
+			};
+			/// Allocator of the slot storage
+			using entry_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<entry>;
+			/// Storage of the slots, shared by the emissions of thread safe
+			/// signals, and called directly otherwise.
+			using entry_storage = typename std::conditional<
+				std::is_base_of<singlethread_policy, P>::value,
+				detail::direct_entries<entry, entry_allocator>,
+				detail::shared_entries<entry, entry_allocator>>::type;
+			/// Slots released by a modification of the storage, that are
+			/// released after unlocking the signal mutex.
+			using stale_type = typename entry_storage::stale_type;
+
+			/// Call a slot as part of a emission, letting the instrument
+			/// observe the call.
+			static R invoke( emission_type& emission, std::size_t index, F& slot, A const&... args ) {
+				detail::slot_scope<emission_type> scope{ emission, index };
+				return slot( args... );
+			}
+
+			/// Retrieve the slots connected when the signal is triggered.
+			typename entry_storage::view_type view_slots() const {
+				operation_lock lock{ _mutex, lock_operation::emit };
+				return _slots.view();
+			}
+
+			/// Implementation of the signal accumulator function call
+			template <class T, class Op>
+			typename signal_accumulator<homogeneous_signal_type, T, Op, A...>::result_type trigger_with_accumulator( T value, Op& func, A const&... args ) const {
+				emission_type emission{ _instrument };
+				auto slots = view_slots();
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					auto& current = slots[i];
+					if( current.connected ) {
+						value = func( std::move(value), invoke( emission, i, current.slot, args... ) );
+					}
+				}
+				return value;
+			}
+
+			/// Implementation of the disconnection operation.
+			/// @param index   The slot index of the slot that should
+			///                be disconnected.
+			void disconnect( std::size_t index ) {
+				stale_type stale;
+				operation_lock lock{ _mutex, lock_operation::disconnect };
+				assert( _slots.size() > index );
+				bool const disconnected = _slots.release( index, stale );
+				this->on_disconnected( index, disconnected, _slots.size() );
+			}
+
+			/// Disconnect a slot from a signal, called through the shared
+			/// disconnector of the signal base.
+			static void disconnect_slot( detail::signal_base& base, std::size_t index ) {
+				static_cast<homogeneous_signal_type&>( base ).disconnect( index );
+			}
+
+			/// All slots, including disconnected slots that are followed by
+			/// connected slots.
+			entry_storage _slots;
+	};
+
+	/// Static signal template specialization.
+	///
+	/// This is a signal with a fixed set of slots, the functions `F...`,
+	/// that is wired at compile time. Slots can't be connected or
+	/// disconnected, so there is no slot storage, locking or allocation,
+	/// and triggering the signal expands to direct calls of the functions,
+	/// in the order they are listed.
+	///
+	/// @code
+	/// void log( int );
+	/// void count( int );
+	/// nod::static_signal<void(int), &log, &count> signal;
+	/// signal( 42 );   // calls log( 42 ) and count( 42 )
+	/// @endcode
 	///
-	/// Only use this signal type if you are sure that your environment is
-	/// single threaded and performance is of importance.
-	template <class T> using unsafe_signal = signal_type<singlethread_policy, T>;
+	/// @tparam R      Return value type of the slots.
+	/// @tparam A...   Argument types of the slots.
+	/// @tparam F...   The slots of the signal.
+	template <class R, class... A, R(*... F)(A...)>
+	class static_signal<R(A...), F...>
+	{
+		public:
+			/// Return type of the slots.
+			using slot_result_type = R;
+			/// Type that is used for counting the slots of this signal type.
+			using size_type = std::size_t;
+
+			/// Function call operator, triggering the signal.
+			///
+			/// @note The slots will be called in the order they are listed
+			///       in the signal type.
+			///
+			/// @param args   Arguments that will be propagated to the
+			///               slots when they are called.
+			void operator()( A const&... args ) const {
+				(void)detail::expand{ 0, ( (void)F( args... ), 0 )... };
+			}
+
+			/// Construct a accumulator proxy object for the signal, see
+			/// `nod::signal_type::accumulate`.
+			template <class T, class Op>
+			signal_accumulator<static_signal, T, Op, A...> accumulate( T init, Op op ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to accumulate slot return values with 'void' as return type." );
+				return { *this, init, op };
+			}
+
+			/// Trigger the signal, calling the slots and aggregate all
+			/// the slot return values into a container.
+			/// @tparam C     The type of container, which must be default
+			///               constructible and have a `push_back` method.
+			/// @param args   The arguments to propagate to the slots.
+			template <class C>
+			C aggregate( A const&... args ) const {
+				static_assert( std::is_same<R,void>::value == false, "Unable to aggregate slot return values with 'void' as return type." );
+				C container;
+				detail::reserve( container, sizeof...(F), 0 );
+				(void)detail::expand{ 0, ( container.push_back( F( args... ) ), 0 )... };
+				return container;
+			}
+
+			/// Count the number of slots of this signal
+			/// @returns   The number of slots
+			static constexpr size_type slot_count() {
+				return sizeof...(F);
+			}
+
+			/// Determine if the signal is empty, i.e. has no slots.
+			static constexpr bool empty() {
+				return sizeof...(F) == 0;
+			}
+
+		private:
+			template<class, class, class, class...> friend class signal_accumulator;
+
+			/// Implementation of the signal accumulator function call
+			template <class T, class Op>
+			typename signal_accumulator<static_signal, T, Op, A...>::result_type trigger_with_accumulator( T value, Op& func, A const&... args ) const {
+				(void)detail::expand{ 0, ( value = func( std::move(value), F( args... ) ), 0 )... };
+				return value;
+			}
+	};
+
+	// The signal, unsafe_signal, homogeneous_signal and unsafe_homogeneous_signal
+	// aliases are declared in nod_fwd.hpp.
 } // namespace nod
 
+// Explicit instantiation of commonly used signal types.
+//
+// Every translation unit using a signal type instantiates its members.
+// Signal types used in many translation units can instead be declared with
+// NOD_EXTERN_SIGNAL in a shared header, and instantiated once with
+// NOD_INSTANTIATE_SIGNAL in a single source file:
+//
+//     // signals.hpp
+//     #include <nod/nod.hpp>
+//     NOD_EXTERN_SIGNAL( void(int, std::string const&) )
+//
+//     // signals.cpp
+//     #include "signals.hpp"
+//     NOD_INSTANTIATE_SIGNAL( void(int, std::string const&) )
+//
+// The _TYPE variants take the thread policy as first argument. Member
+// templates, like connect() and accumulate(), are still instantiated where
+// they are used.
+#define NOD_EXTERN_SIGNAL_TYPE( P, ... ) extern template class nod::signal_type<P, __VA_ARGS__>;
+#define NOD_INSTANTIATE_SIGNAL_TYPE( P, ... ) template class nod::signal_type<P, __VA_ARGS__>;
+#define NOD_EXTERN_SIGNAL( ... ) NOD_EXTERN_SIGNAL_TYPE( nod::multithread_policy, __VA_ARGS__ )
+#define NOD_INSTANTIATE_SIGNAL( ... ) NOD_INSTANTIATE_SIGNAL_TYPE( nod::multithread_policy, __VA_ARGS__ )
+#define NOD_EXTERN_UNSAFE_SIGNAL( ... ) NOD_EXTERN_SIGNAL_TYPE( nod::singlethread_policy, __VA_ARGS__ )
+#define NOD_INSTANTIATE_UNSAFE_SIGNAL( ... ) NOD_INSTANTIATE_SIGNAL_TYPE( nod::singlethread_policy, __VA_ARGS__ )
+
 #endif // IG_NOD_INCLUDE_NOD_HPP
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef IG_NOD_INCLUDE_NOD_FWD_HPP
+#define IG_NOD_INCLUDE_NOD_FWD_HPP
+
+// Forward declarations of the nod types.
+//
+// This header doesn't include any standard library headers, and can be
+// included instead of nod.hpp where signals and connections are only
+// referred to by pointer or reference, like in the declarations of
+// functions taking a signal, or of classes holding a signal through a
+// std::unique_ptr.
+
+namespace nod {
+	/// Base template for the signal class
+	template <class P, class T>
+	class signal_type;
+
+	/// Connection class, see nod.hpp
+	class connection;
+
+	/// Scoped connection class, see nod.hpp
+	class scoped_connection;
+
+	/// Policy for multi threaded use of signals, see nod.hpp
+	struct multithread_policy;
+
+	/// Policy for single threaded use of signals, see nod.hpp
+	struct singlethread_policy;
+
+	/// Signal type that is safe to use in multithreaded environments,
+	/// where the signal and slots exists in different threads.
+	/// The multithreaded policy provides mutexes and locks to synchronize
+	/// access to the signals internals.
+	///
+	/// This is the recommended signal type, even for single threaded
+	/// environments.
+	template <class T> using signal = signal_type<multithread_policy, T>;
+
+	/// Signal type that is unsafe in multithreaded environments.
+	/// No synchronizations are provided to the signal_type for accessing
+	/// the internals.
+	///
+	/// Only use this signal type if you are sure that your environment is
+	/// single threaded and performance is of importance.
+	template <class T> using unsafe_signal = signal_type<singlethread_policy, T>;
+
+	/// Base template for the homogeneous signal class
+	template <class P, class F, class T>
+	class homogeneous_signal_type;
+
+	/// Thread safe signal for slots of the single type `F`, see
+	/// `nod::homogeneous_signal_type`.
+	template <class F, class T> using homogeneous_signal = homogeneous_signal_type<multithread_policy, F, T>;
+
+	/// Signal for slots of the single type `F`, that is unsafe in
+	/// multithreaded environments.
+	template <class F, class T> using unsafe_homogeneous_signal = homogeneous_signal_type<singlethread_policy, F, T>;
+
+	/// Base template for the static signal class, with the slots `F...`
+	/// fixed at compile time.
+	template <class T, T*... F>
+	class static_signal;
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_FWD_HPP
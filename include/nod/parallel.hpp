@@ -0,0 +1,347 @@
+#ifndef IG_NOD_INCLUDE_NOD_PARALLEL_HPP
+#define IG_NOD_INCLUDE_NOD_PARALLEL_HPP
+
+// Parallel accumulation of slot return values, see
+// nod::signal_type::accumulate_parallel().
+//
+// The accumulator and the pool of worker threads it uses are declared in
+// their own header, so that translation units that don't accumulate in
+// parallel don't parse them.
+
+#include "nod.hpp"
+
+#include <algorithm>    // std::min(), std::max()
+#include <condition_variable> // std::condition_variable
+#include <cstddef>      // std::size_t
+#include <exception>    // std::exception_ptr
+#include <mutex>        // std::mutex, std::unique_lock
+#include <thread>       // std::thread
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+namespace nod {
+	// implementational details
+	namespace detail {
+		/// Pool of worker threads, calling the chunks of parallel jobs.
+		///
+		/// The threads are started once, and wait for jobs between uses.
+		/// The thread submitting a job calls the chunks of the job that
+		/// no worker has claimed yet, and then waits for the claimed chunks
+		/// to finish. A job therefore completes even if all workers are
+		/// busy, which also makes it safe to submit jobs from a chunk.
+		class worker_pool {
+			public:
+				/// Start a pool with a number of threads
+				explicit worker_pool( std::size_t threads ) :
+					_jobs( nullptr ),
+					_stop( false )
+				{
+					_threads.reserve( threads );
+					for( std::size_t i = 0; i < threads; ++i ) {
+						_threads.emplace_back( [this](){ work(); } );
+					}
+				}
+
+				worker_pool( worker_pool const& ) = delete;
+				worker_pool& operator=( worker_pool const& ) = delete;
+
+				/// Wait for the threads to finish their current chunks, and
+				/// stop them.
+				~worker_pool() {
+					{
+						std::lock_guard<std::mutex> lock{ _mutex };
+						_stop = true;
+					}
+					_work.notify_all();
+					for( auto& thread : _threads ) {
+						thread.join();
+					}
+				}
+
+				/// @returns The pool shared by all signals, with one thread
+				///          less than the number of concurrent threads
+				///          supported by the hardware.
+				static worker_pool& instance() {
+					static worker_pool pool{ std::max<std::size_t>( std::thread::hardware_concurrency(), 1 ) - 1 };
+					return pool;
+				}
+
+				/// @returns The number of worker threads
+				std::size_t size() const {
+					return _threads.size();
+				}
+
+				/// Call a function for each chunk of a job, and wait for all
+				/// chunks to finish. The chunks are called concurrently, by
+				/// the workers and the calling thread.
+				///
+				/// If a chunk throws, the exception is rethrown once all
+				/// chunks have finished.
+				///
+				/// @param chunks   The number of chunks.
+				/// @param func     Function called with the index of each chunk.
+				template <class F>
+				void run( std::size_t chunks, F& func ) {
+					if( chunks == 0 ) {
+						return;
+					}
+					job j;
+					j.call = []( void* f, std::size_t chunk ) { (*static_cast<F*>( f ))( chunk ); };
+					j.func = &func;
+					j.chunks = chunks;
+					j.claimed = 0;
+					j.finished = 0;
+					j.next = nullptr;
+					std::unique_lock<std::mutex> lock{ _mutex };
+					job** tail = &_jobs;
+					while( *tail != nullptr ) {
+						tail = &(*tail)->next;
+					}
+					*tail = &j;
+					lock.unlock();
+					for( std::size_t i = 1; i < chunks && i <= _threads.size(); ++i ) {
+						_work.notify_one();
+					}
+					lock.lock();
+					while( j.claimed < chunks ) {
+						execute( j, lock );
+					}
+					_finished.wait( lock, [&j](){ return j.finished == j.chunks; } );
+					if( j.error ) {
+						std::rethrow_exception( j.error );
+					}
+				}
+
+			private:
+				/// A job submitted to the pool, owned by the submitting thread
+				struct job {
+					/// Calls `func` for a chunk
+					void (*call)( void*, std::size_t );
+					void* func;
+					std::size_t chunks;
+					/// Number of chunks claimed by a thread
+					std::size_t claimed;
+					/// Number of chunks finished
+					std::size_t finished;
+					/// First exception thrown by a chunk
+					std::exception_ptr error;
+					/// Next job with unclaimed chunks
+					job* next;
+				};
+
+				/// Claim the next chunk of a job, and call it without holding
+				/// the mutex. The job is removed from the pool once all its
+				/// chunks are claimed.
+				void execute( job& j, std::unique_lock<std::mutex>& lock ) {
+					std::size_t const chunk = j.claimed++;
+					if( j.claimed == j.chunks ) {
+						job** link = &_jobs;
+						while( *link != &j ) {
+							link = &(*link)->next;
+						}
+						*link = j.next;
+					}
+					lock.unlock();
+					std::exception_ptr error;
+					try {
+						j.call( j.func, chunk );
+					}
+					catch( ... ) {
+						error = std::current_exception();
+					}
+					lock.lock();
+					if( error && !j.error ) {
+						j.error = error;
+					}
+					if( ++j.finished == j.chunks ) {
+						_finished.notify_all();
+					}
+				}
+
+				/// Loop of the worker threads
+				void work() {
+					std::unique_lock<std::mutex> lock{ _mutex };
+					for( ;; ) {
+						_work.wait( lock, [this](){ return _stop || _jobs != nullptr; } );
+						if( _stop ) {
+							return;
+						}
+						execute( *_jobs, lock );
+					}
+				}
+
+				/// Mutex protecting the jobs
+				std::mutex _mutex;
+				/// Signaled when a job is submitted
+				std::condition_variable _work;
+				/// Signaled when the last chunk of a job has finished
+				std::condition_variable _finished;
+				/// Jobs with unclaimed chunks, oldest first
+				job* _jobs;
+				/// `true` when the threads should stop
+				bool _stop;
+				/// The worker threads
+				std::vector<std::thread> _threads;
+		};
+	} // namespace detail
+
+	/// Signal parallel accumulator class template.
+	///
+	/// This acts as a proxy for triggering a signal and reducing the
+	/// slot return values with an associative operation, where the
+	/// slots are called from several worker threads.
+	///
+	/// This class is not really intended to instantiate by client code.
+	/// Instances are aquired as return values of the method
+	/// `accumulate_parallel()` called on signals.
+	///
+	/// @tparam S      Type of signal. The signal_parallel_accumulator acts
+	///                as a type of proxy for a signal instance of
+	///                this type.
+	/// @tparam T      Type of initial value and result of the reduction.
+	///                This type must meet the requirements of
+	///                `CopyConstructible` and `MoveConstructible`.
+	/// @tparam F      Type of the associative reduction function.
+	/// @tparam A...   Argument types of the underlying signal type.
+	///
+	template <class S, class T, class F, class...A>
+	class signal_parallel_accumulator
+	{
+		public:
+			/// Result type when calling the accumulating function operator.
+			using result_type = T;
+
+			/// Construct a signal_parallel_accumulator as a proxy to a given signal
+			///
+			/// @param signal        Signal instance.
+			/// @param init          Initial value of the reduction.
+			/// @param func          Associative binary operation function object,
+			///                      with a signature equivalent of `T func( T, T )`.
+			/// @param max_workers   Maximum number of threads used to call the
+			///                      slots, including the triggering thread.
+			/// @param min_slots_per_worker   Minimum number of slots called by
+			///                      each thread.
+			signal_parallel_accumulator( S const& signal, T init, F func, std::size_t max_workers, std::size_t min_slots_per_worker ) :
+				_signal( signal ),
+				_init( init ),
+				_func( func ),
+				_max_workers( max_workers ),
+				_min_slots_per_worker( min_slots_per_worker )
+			{}
+
+			/// Function call operator.
+			///
+			/// Calling this will trigger the underlying signal and reduce
+			/// all of the connected slots return values with the current
+			/// initial value and reduction function.
+			///
+			/// @param args   Arguments to propagate to the slots of the
+			///               underlying when triggering the signal.
+			result_type operator()( A const&... args ) const {
+				auto& pool = detail::worker_pool::instance();
+				std::size_t max_workers = _max_workers;
+				if( max_workers == 0 || max_workers > pool.size() + 1 ) {
+					max_workers = pool.size() + 1;
+				}
+				emission_type emission{ _signal._instrument };
+				auto slots = _signal.snapshot_slots();
+				// Calls all slots on this thread.
+				auto sequential = [&]() {
+					detail::lazy_value<T> result;
+					result.emplace( _init );
+					reduce_slots( emission, slots, slots.size(), []( std::size_t i ) { return i; }, result, args... );
+					return T( std::move( result.get() ) );
+				};
+				std::size_t const chunk_limit = slots.size() / std::max<std::size_t>( _min_slots_per_worker, 1 );
+				if( max_workers <= 1 || chunk_limit <= 1 ) {
+					// Handing chunks to the workers would cost more than
+					// calling the slots on this thread.
+					return sequential();
+				}
+				std::vector<std::size_t> live;
+				live.reserve( slots.size() );
+				for( std::size_t i = 0; i < slots.size(); ++i ) {
+					if( slots[i] ) {
+						live.push_back( i );
+					}
+				}
+				std::size_t const workers = std::min( std::min( max_workers, chunk_limit ), live.size() );
+				if( workers <= 1 ) {
+					return sequential();
+				}
+				std::size_t const chunk = live.size() / workers;
+				std::size_t const remainder = live.size() % workers;
+				// Reduce one chunk of slots, starting with the first slots return value.
+				std::vector<detail::lazy_value<T>> partials( workers );
+				auto reduce = [&]( std::size_t w ) {
+					std::size_t const first = w * chunk + std::min( w, remainder );
+					std::size_t const count = chunk + (w < remainder ? 1 : 0);
+					reduce_slots( emission, slots, count, [&live, first]( std::size_t i ) { return live[first + i]; }, partials[w], args... );
+				};
+				pool.run( workers, reduce );
+				// Combine the partial results pairwise, preserving operand
+				// order. Each level is built into a new vector, so T doesn't
+				// need to be default constructible or assignable.
+				std::vector<T> level;
+				level.reserve( workers );
+				for( auto& partial : partials ) {
+					level.emplace_back( std::move( partial.get() ) );
+				}
+				while( level.size() > 1 ) {
+					std::vector<T> next;
+					next.reserve( (level.size() + 1) / 2 );
+					for( std::size_t i = 0; i + 1 < level.size(); i += 2 ) {
+						next.emplace_back( _func( std::move(level[i]), std::move(level[i+1]) ) );
+					}
+					if( level.size() % 2 != 0 ) {
+						next.emplace_back( std::move( level.back() ) );
+					}
+					level.swap( next );
+				}
+				return _func( _init, std::move(level.front()) );
+			}
+
+		private:
+			/// Type of the scope of a single emission of the signal.
+			using emission_type = typename S::emission_type;
+			/// Snapshot of the slots of the signal.
+			using snapshot_type = typename S::snapshot_type;
+
+			/// Reduce the return values of a number of slots into a value,
+			/// which is constructed from the first return value if it's
+			/// empty. The value is replaced by constructing it, so T doesn't
+			/// need to be assignable.
+			/// @param count      The number of slots to call.
+			/// @param index_of   Function returning the snapshot index of the
+			///                   n:th slot to call. Empty slots are skipped.
+			template <class I>
+			void reduce_slots( emission_type& emission, snapshot_type const& slots, std::size_t count, I const& index_of, detail::lazy_value<T>& value, A const&... args ) const {
+				for( std::size_t n = 0; n < count; ++n ) {
+					std::size_t const i = index_of( n );
+					if( !slots[i] ) {
+						continue;
+					}
+					if( !value.has_value() ) {
+						value.emplace( S::invoke( emission, i, *slots[i], args... ) );
+						continue;
+					}
+					T next = _func( std::move( value.get() ), S::invoke( emission, i, *slots[i], args... ) );
+					value.reset();
+					value.emplace( std::move(next) );
+				}
+			}
+
+			/// Reference to the underlying signal to proxy.
+			S const& _signal;
+			/// Initial value of the reduction.
+			T _init;
+			/// Reduction function.
+			F _func;
+			/// Maximum number of worker threads.
+			std::size_t _max_workers;
+			/// Minimum number of slots called by each thread.
+			std::size_t _min_slots_per_worker;
+	};
+} // namespace nod
+
+#endif // IG_NOD_INCLUDE_NOD_PARALLEL_HPP
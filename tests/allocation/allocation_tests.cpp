@@ -0,0 +1,257 @@
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <cstdlib>    // std::malloc, std::free
+#include <functional> // std::function
+#include <memory>     // std::shared_ptr
+#include <new>        // std::bad_alloc
+#include <vector>     // std::vector
+
+// The global allocation functions are replaced by counting versions, which
+// is why these tests are built as a executable of their own. Allocations are
+// counted per thread, so that allocations made by other threads don't
+// disturb the measurements.
+//
+// Where nod guarantees that nothing is allocated, the tests require exactly
+// zero allocations. Other counts depend on the standard library, like the
+// small buffer of std::function or the placement of shared_ptr control
+// blocks, and are compared with the allocations made by the same standard
+// library types outside of nod.
+namespace {
+	thread_local std::size_t allocation_count = 0;
+
+	void* counted_allocation( std::size_t size ) {
+		++allocation_count;
+		void* ptr = std::malloc( size != 0 ? size : 1 );
+		if( ptr == nullptr ) {
+			throw std::bad_alloc{};
+		}
+		return ptr;
+	}
+
+	/// Counts the allocations made by the current thread, from the
+	/// construction of the counter.
+	class allocation_counter
+	{
+		public:
+			allocation_counter() :
+				_start( allocation_count )
+			{}
+
+			/// @returns The number of allocations since the counter was created
+			std::size_t count() const {
+				return allocation_count - _start;
+			}
+
+		private:
+			std::size_t _start;
+	};
+
+	/// Slot without captured state, that is stored in a std::function
+	/// without allocating.
+	int slot( int x ) {
+		return x;
+	}
+
+	/// Connect a number of slots to a signal
+	template <class S>
+	std::vector<nod::connection> connect_slots( S& signal, std::size_t count ) {
+		std::vector<nod::connection> connections;
+		for( std::size_t i = 0; i < count; ++i ) {
+			connections.push_back( signal.connect( slot ) );
+		}
+		return connections;
+	}
+
+	/// Slot counts to measure allocations for
+	std::size_t const slot_counts[] = { 0, 1, 8, 64 };
+
+	/// @returns The number of allocations made by calling a function
+	template <class F>
+	std::size_t allocations_of( F func ) {
+		allocation_counter counter;
+		func();
+		return counter.count();
+	}
+
+	/// @returns The allocations of a slot holding the test slot
+	std::size_t slot_baseline() {
+		return allocations_of( [](){
+				std::function<int(int)> function{ slot };
+			});
+	}
+
+	/// @returns The allocations of a shared pointer not owning its object
+	std::size_t shared_baseline() {
+		return allocations_of( [](){
+				static int object = 0;
+				std::shared_ptr<int> shared{ &object, []( int* ){} };
+			});
+	}
+
+	/// @returns The allocations of adding the first element to a vector
+	///          of slots.
+	std::size_t vector_baseline() {
+		return allocations_of( [](){
+				std::vector<std::function<int(int)>> v;
+				v.push_back( nullptr );
+			});
+	}
+
+	/// @returns The allocations of a buffer for copies of a given number
+	///          of slots.
+	std::size_t buffer_baseline( std::size_t size ) {
+		return allocations_of( [size](){
+				std::vector<std::function<int(int)>> v;
+				v.reserve( size );
+			});
+	}
+
+	/// @returns The allocations of a vector of ints with reserved capacity
+	std::size_t container_baseline( std::size_t size ) {
+		return allocations_of( [size](){
+				std::vector<int> v;
+				v.reserve( size );
+			});
+	}
+}	// anonymous namespace
+
+void* operator new( std::size_t size ) {
+	return counted_allocation( size );
+}
+
+void* operator new[]( std::size_t size ) {
+	return counted_allocation( size );
+}
+
+void operator delete( void* ptr ) noexcept {
+	std::free( ptr );
+}
+
+void operator delete[]( void* ptr ) noexcept {
+	std::free( ptr );
+}
+
+SCENARIO( "Connecting and disconnecting slots allocates a bounded number of times" ) {
+	GIVEN( "a signal without connected slots" ) {
+		nod::signal<int(int)> signal;
+		WHEN( "we connect the first slot" ) {
+			allocation_counter counter;
+			auto connection = signal.connect( slot );
+			auto const allocations = counter.count();
+			THEN( "at most the slot, the slot vector and the shared disconnector are allocated" ) {
+				REQUIRE( allocations <= slot_baseline() + vector_baseline() + shared_baseline() );
+			}
+		}
+	}
+	GIVEN( "a signal with spare slot capacity" ) {
+		nod::signal<int(int)> signal;
+		auto connections = connect_slots( signal, 4 );
+		connections.back().disconnect();
+		WHEN( "we connect another slot" ) {
+			allocation_counter counter;
+			auto connection = signal.connect( slot );
+			auto const allocations = counter.count();
+			THEN( "at most the slot is allocated" ) {
+				REQUIRE( allocations <= slot_baseline() );
+			}
+		}
+	}
+	GIVEN( "a signal with connected slots" ) {
+		nod::signal<int(int)> signal;
+		auto connections = connect_slots( signal, 8 );
+		WHEN( "we disconnect all the slots" ) {
+			allocation_counter counter;
+			for( auto& connection : connections ) {
+				connection.disconnect();
+			}
+			auto const allocations = counter.count();
+			THEN( "nothing is allocated" ) {
+				REQUIRE( allocations == 0 );
+			}
+		}
+	}
+}
+
+SCENARIO( "Triggering signals allocates a bounded number of times" ) {
+	GIVEN( "signals with different numbers of connected slots" ) {
+		for( auto const count : slot_counts ) {
+			INFO( "Number of slots: " << count );
+			nod::signal<int(int)> signal;
+			auto connections = connect_slots( signal, count );
+			// The first emission allocates a buffer for the copies of the
+			// slots, unless the thread already has a large enough one.
+			std::size_t const snapshot = buffer_baseline( count );
+			// Aggregating allocates the container.
+			std::size_t const container = container_baseline( count );
+
+			allocation_counter emit_counter;
+			signal( 42 );
+			auto const emit_allocations = emit_counter.count();
+			REQUIRE( emit_allocations <= snapshot );
+
+			// Following emissions copy the slots into the same buffer.
+			allocation_counter repeated_emit_counter;
+			signal( 42 );
+			signal( 42 );
+			auto const repeated_emit_allocations = repeated_emit_counter.count();
+			REQUIRE( repeated_emit_allocations == 0 );
+
+			auto accumulator = signal.accumulate( 0, std::plus<int>{} );
+			allocation_counter accumulate_counter;
+			accumulator( 42 );
+			auto const accumulate_allocations = accumulate_counter.count();
+			REQUIRE( accumulate_allocations == 0 );
+
+			allocation_counter aggregate_counter;
+			signal.aggregate<std::vector<int>>( 42 );
+			auto const aggregate_allocations = aggregate_counter.count();
+			REQUIRE( aggregate_allocations <= container );
+
+			std::vector<int> results;
+			signal.aggregate_into( results, 42 );
+			allocation_counter aggregate_into_counter;
+			signal.aggregate_into( results, 42 );
+			auto const aggregate_into_allocations = aggregate_into_counter.count();
+			REQUIRE( aggregate_into_allocations == 0 );
+
+			allocation_counter disconnect_counter;
+			for( auto& connection : connections ) {
+				connection.disconnect();
+			}
+			auto const disconnect_allocations = disconnect_counter.count();
+			REQUIRE( disconnect_allocations == 0 );
+		}
+	}
+	GIVEN( "a triggered signal" ) {
+		nod::signal<int(int)> signal;
+		auto connections = connect_slots( signal, 4 );
+		connections.back().disconnect();
+		signal( 42 );
+		WHEN( "we connect another slot and trigger the signal again" ) {
+			signal.connect( slot );
+			allocation_counter counter;
+			signal( 42 );
+			auto const allocations = counter.count();
+			THEN( "at most a larger buffer is allocated" ) {
+				REQUIRE( allocations <= buffer_baseline( 4 ) );
+			}
+		}
+	}
+	GIVEN( "a signal with a slot triggering another signal" ) {
+		nod::signal<int(int)> inner;
+		auto connections = connect_slots( inner, 4 );
+		nod::signal<int(int)> outer;
+		outer.connect( [&inner]( int x ) { inner( x ); return x; } );
+		outer( 42 );
+		WHEN( "we trigger the signal again" ) {
+			allocation_counter counter;
+			outer( 42 );
+			outer( 42 );
+			auto const allocations = counter.count();
+			THEN( "the nested emissions reuse their buffers" ) {
+				REQUIRE( allocations == 0 );
+			}
+		}
+	}
+}
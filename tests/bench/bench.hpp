@@ -0,0 +1,131 @@
+#ifndef IG_BENCH_BENCH_HPP
+#define IG_BENCH_BENCH_HPP
+
+#include <chrono>       // std::chrono::steady_clock
+#include <cstddef>      // std::size_t
+#include <functional>   // std::function
+#include <string>       // std::string
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+
+namespace bench
+{
+	/// Clock used for all measurements
+	using clock = std::chrono::steady_clock;
+
+	/// Prevent the compiler from optimizing away a value that is
+	/// otherwise unused by the benchmark.
+	template <class T>
+	inline void do_not_optimize( T const& value ) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile( "" : : "r,m"(value) : "memory" );
+#else
+		static volatile char sink;
+		sink = *reinterpret_cast<char const volatile*>( &value );
+#endif
+	}
+
+	/// State of a running benchmark.
+	///
+	/// A benchmark function does its setup, and then loops while
+	/// `keep_running()` returns true. Only the time spent in the loop
+	/// is measured.
+	///
+	/// Benchmarks that can't use the loop, like benchmarks running
+	/// the iterations on several threads, measure the time themself
+	/// and report it with `set_elapsed()`.
+	class state
+	{
+		public:
+			/// Create a state that will run a given number of iterations
+			explicit state( std::size_t iterations ) :
+				_iterations( iterations ),
+				_remaining( iterations ),
+				_started( false )
+			{}
+
+			/// @returns `true` as long as there are iterations left to run.
+			bool keep_running() {
+				if( !_started ) {
+					_started = true;
+					_start = clock::now();
+				}
+				if( _remaining == 0 ) {
+					_stop = clock::now();
+					return false;
+				}
+				--_remaining;
+				return true;
+			}
+
+			/// @returns The number of iterations to run.
+			std::size_t iterations() const {
+				return _iterations;
+			}
+
+			/// @returns The time spent in the benchmark loop.
+			clock::duration elapsed() const {
+				return _stop - _start;
+			}
+
+			/// Report the time spent running all iterations, for benchmarks
+			/// that measure the time themself.
+			void set_elapsed( clock::duration elapsed ) {
+				_start = clock::time_point{};
+				_stop = _start + elapsed;
+			}
+
+			/// Report a named value measured by the benchmark, like a
+			/// throughput or a latency percentile.
+			void set_counter( std::string name, double value ) {
+				for( auto& counter : _counters ) {
+					if( counter.first == name ) {
+						counter.second = value;
+						return;
+					}
+				}
+				_counters.emplace_back( std::move(name), value );
+			}
+
+			/// @returns The counters reported by the benchmark.
+			std::vector<std::pair<std::string,double>> const& counters() const {
+				return _counters;
+			}
+
+		private:
+			std::size_t _iterations;
+			std::size_t _remaining;
+			bool _started;
+			clock::time_point _start;
+			clock::time_point _stop;
+			std::vector<std::pair<std::string,double>> _counters;
+	};
+
+	/// Type of the benchmark functions
+	using function = std::function<void(state&)>;
+
+	/// A registered benchmark
+	struct benchmark
+	{
+		std::string name;
+		function func;
+	};
+
+	/// @returns All registered benchmarks
+	inline std::vector<benchmark>& registry() {
+		static std::vector<benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	/// Registration of benchmarks, intended to be used for static
+	/// objects in the benchmark translation units.
+	struct registration
+	{
+		registration( std::string name, function func ) {
+			registry().push_back( benchmark{ std::move(name), std::move(func) } );
+		}
+	};
+
+}	// namespace bench
+
+#endif // IG_BENCH_BENCH_HPP
@@ -0,0 +1,94 @@
+#include "bench.hpp"
+#include <nod/nod.hpp>
+
+namespace {
+
+	/// Connect and disconnect a slot, on a signal with a given number
+	/// of other slots already connected.
+	template <class S>
+	void connect_disconnect( bench::state& state, std::size_t slots ) {
+		S signal;
+		std::vector<nod::connection> connections;
+		for( std::size_t i = 0; i < slots; ++i ) {
+			connections.push_back( signal.connect( [](){} ) );
+		}
+		while( state.keep_running() ) {
+			auto connection = signal.connect( [](){} );
+			connection.disconnect();
+		}
+		bench::do_not_optimize( signal.slot_count() );
+	}
+
+	/// Connect a batch of slots, and then disconnect them all
+	template <class S>
+	void connect_batch( bench::state& state, std::size_t slots ) {
+		S signal;
+		std::vector<nod::connection> connections;
+		connections.reserve( slots );
+		while( state.keep_running() ) {
+			for( std::size_t i = 0; i < slots; ++i ) {
+				connections.push_back( signal.connect( [](){} ) );
+			}
+			for( auto& connection : connections ) {
+				connection.disconnect();
+			}
+			connections.clear();
+		}
+		bench::do_not_optimize( signal.slot_count() );
+	}
+
+	/// Create and destroy scoped connections
+	template <class S>
+	void scoped_churn( bench::state& state, std::size_t slots ) {
+		S signal;
+		std::vector<nod::scoped_connection> connections;
+		for( std::size_t i = 0; i < slots; ++i ) {
+			connections.emplace_back( signal.connect( [](){} ) );
+		}
+		while( state.keep_running() ) {
+			nod::scoped_connection connection = signal.connect( [](){} );
+			bench::do_not_optimize( connection );
+		}
+		bench::do_not_optimize( signal.slot_count() );
+	}
+
+	/// Connect a slot and trigger the signal, on a signal with a given
+	/// number of other slots connected. This is the pattern of a reconnect
+	/// storm on a signal with many subscribers, where each emission sees
+	/// a modified slot list.
+	template <class S>
+	void connect_emit( bench::state& state, std::size_t slots ) {
+		S signal;
+		std::vector<nod::connection> connections;
+		for( std::size_t i = 0; i < slots; ++i ) {
+			connections.push_back( signal.connect( [](){} ) );
+		}
+		std::size_t next = 0;
+		while( state.keep_running() ) {
+			connections[next].disconnect();
+			connections[next] = signal.connect( [](){} );
+			next = (next + 1) % slots;
+			signal();
+		}
+		bench::do_not_optimize( signal.slot_count() );
+	}
+
+	bench::registration connect_signal_0{ "connect_disconnect/signal/0", []( bench::state& s ) { connect_disconnect<nod::signal<void()>>( s, 0 ); } };
+	bench::registration connect_signal_64{ "connect_disconnect/signal/64", []( bench::state& s ) { connect_disconnect<nod::signal<void()>>( s, 64 ); } };
+	bench::registration connect_unsafe_0{ "connect_disconnect/unsafe_signal/0", []( bench::state& s ) { connect_disconnect<nod::unsafe_signal<void()>>( s, 0 ); } };
+	bench::registration connect_unsafe_64{ "connect_disconnect/unsafe_signal/64", []( bench::state& s ) { connect_disconnect<nod::unsafe_signal<void()>>( s, 64 ); } };
+
+	bench::registration batch_signal_64{ "connect_batch/signal/64", []( bench::state& s ) { connect_batch<nod::signal<void()>>( s, 64 ); } };
+	bench::registration batch_signal_1024{ "connect_batch/signal/1024", []( bench::state& s ) { connect_batch<nod::signal<void()>>( s, 1024 ); } };
+	bench::registration batch_unsafe_64{ "connect_batch/unsafe_signal/64", []( bench::state& s ) { connect_batch<nod::unsafe_signal<void()>>( s, 64 ); } };
+	bench::registration batch_unsafe_1024{ "connect_batch/unsafe_signal/1024", []( bench::state& s ) { connect_batch<nod::unsafe_signal<void()>>( s, 1024 ); } };
+
+	bench::registration scoped_signal_0{ "scoped_connection/signal/0", []( bench::state& s ) { scoped_churn<nod::signal<void()>>( s, 0 ); } };
+	bench::registration scoped_signal_64{ "scoped_connection/signal/64", []( bench::state& s ) { scoped_churn<nod::signal<void()>>( s, 64 ); } };
+	bench::registration scoped_unsafe_0{ "scoped_connection/unsafe_signal/0", []( bench::state& s ) { scoped_churn<nod::unsafe_signal<void()>>( s, 0 ); } };
+	bench::registration scoped_unsafe_64{ "scoped_connection/unsafe_signal/64", []( bench::state& s ) { scoped_churn<nod::unsafe_signal<void()>>( s, 64 ); } };
+
+	bench::registration connect_emit_signal_10000{ "connect_emit/signal/10000", []( bench::state& s ) { connect_emit<nod::signal<void()>>( s, 10000 ); } };
+	bench::registration connect_emit_persistent_10000{ "connect_emit/persistent_slots/10000", []( bench::state& s ) { connect_emit<nod::signal_type<nod::persistent_slots_policy<>, void()>>( s, 10000 ); } };
+
+}	// anonymous namespace
@@ -0,0 +1,215 @@
+#include "bench.hpp"
+#include "histogram.hpp"
+#include <nod/nod.hpp>
+
+#include <atomic>       // std::atomic
+#include <memory>       // std::unique_ptr
+#include <thread>       // std::thread
+
+namespace {
+
+	using nanoseconds = std::chrono::duration<double, std::nano>;
+
+	/// @returns The thread counts to measure, doubling from one thread
+	///          up to the number of hardware threads.
+	std::vector<std::size_t> thread_counts() {
+		std::size_t const hardware = std::max<std::size_t>( std::thread::hardware_concurrency(), 1 );
+		std::vector<std::size_t> counts;
+		for( std::size_t count = 1; count < hardware; count *= 2 ) {
+			counts.push_back( count );
+		}
+		counts.push_back( hardware );
+		return counts;
+	}
+
+	/// @returns The duration in nanoseconds between two time points
+	std::uint64_t nanoseconds_between( bench::clock::time_point start, bench::clock::time_point stop ) {
+		return static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( stop - start ).count() );
+	}
+
+	/// Start signal for worker threads, so that all threads start
+	/// working at the same time.
+	class start_gate
+	{
+		public:
+			start_gate() :
+				_waiting( 0 ),
+				_open( false )
+			{}
+
+			/// Wait for the gate to open
+			void wait() {
+				++_waiting;
+				while( !_open.load( std::memory_order_acquire ) ) {
+					std::this_thread::yield();
+				}
+			}
+
+			/// Wait for a number of threads to arrive, and open the gate
+			/// @returns The time point when the gate was opened
+			bench::clock::time_point open( std::size_t threads ) {
+				while( _waiting.load() < threads ) {
+					std::this_thread::yield();
+				}
+				auto now = bench::clock::now();
+				_open.store( true, std::memory_order_release );
+				return now;
+			}
+
+		private:
+			std::atomic<std::size_t> _waiting;
+			std::atomic<bool> _open;
+	};
+
+	/// Report throughput and latency percentiles of a threaded benchmark
+	void report( bench::state& state, std::size_t threads, bench::clock::duration elapsed, bench::histogram const& latencies, char const* prefix ) {
+		state.set_elapsed( elapsed );
+		state.set_counter( "threads", static_cast<double>( threads ) );
+		state.set_counter( "ops_per_second", state.iterations() / std::chrono::duration<double>( elapsed ).count() );
+		std::string const p{ prefix };
+		state.set_counter( p + "p50_ns", static_cast<double>( latencies.percentile( 50.0 ) ) );
+		state.set_counter( p + "p99_ns", static_cast<double>( latencies.percentile( 99.0 ) ) );
+		state.set_counter( p + "p99.9_ns", static_cast<double>( latencies.percentile( 99.9 ) ) );
+	}
+
+	/// Emit a signal from several threads at the same time. The iterations
+	/// are divided between the threads, and every emission is timed.
+	///
+	/// If `churn` is set, a separate thread continuously connects and
+	/// disconnects slots while the emitting threads are running.
+	template <class S = nod::signal<void(int)>>
+	void emit( bench::state& state, std::size_t threads, std::size_t slots, bool churn ) {
+		S signal;
+		for( std::size_t i = 0; i < slots; ++i ) {
+			signal.connect( []( int x ) { bench::do_not_optimize( x ); } );
+		}
+		std::size_t const per_thread = std::max<std::size_t>( state.iterations() / threads, 1 );
+		std::vector<bench::histogram> histograms( threads );
+		std::atomic<bool> done{ false };
+		std::atomic<std::size_t> churn_ops{ 0 };
+		start_gate gate;
+		std::vector<std::thread> workers;
+		for( std::size_t t = 0; t < threads; ++t ) {
+			workers.emplace_back( [&, t]() {
+					auto& histogram = histograms[t];
+					gate.wait();
+					for( std::size_t i = 0; i < per_thread; ++i ) {
+						auto const start = bench::clock::now();
+						signal( static_cast<int>( i ) );
+						histogram.record( nanoseconds_between( start, bench::clock::now() ) );
+					}
+				});
+		}
+		std::thread churner;
+		if( churn ) {
+			churner = std::thread{ [&]() {
+					gate.wait();
+					std::size_t ops = 0;
+					while( !done.load( std::memory_order_relaxed ) ) {
+						auto connection = signal.connect( []( int x ) { bench::do_not_optimize( x ); } );
+						connection.disconnect();
+						ops += 2;
+					}
+					churn_ops = ops;
+				}};
+		}
+		auto const start = gate.open( threads + (churn ? 1 : 0) );
+		for( auto& worker : workers ) {
+			worker.join();
+		}
+		auto const elapsed = bench::clock::now() - start;
+		done = true;
+		if( churner.joinable() ) {
+			churner.join();
+		}
+		bench::histogram latencies;
+		for( auto const& histogram : histograms ) {
+			latencies.merge( histogram );
+		}
+		report( state, threads, elapsed, latencies, "emit_" );
+		if( churn ) {
+			state.set_counter( "churn_ops_per_second", churn_ops / std::chrono::duration<double>( elapsed ).count() );
+		}
+	}
+
+	/// Destroy signals while other threads are disconnecting their slots.
+	///
+	/// Each iteration creates a signal with a few slots per thread, and
+	/// lets every thread disconnect its own slots while the signal is
+	/// destroyed. This exercises the path where the destruction of the
+	/// signal waits for ongoing disconnections to finish.
+	void destroy_race( bench::state& state, std::size_t threads ) {
+		std::size_t const slots_per_thread = 4;
+		std::vector<std::vector<nod::connection>> connections( threads );
+		std::atomic<std::size_t> generation{ 0 };
+		std::atomic<std::size_t> finished{ 0 };
+		std::atomic<bool> stop{ false };
+		start_gate gate;
+		std::vector<std::thread> workers;
+		for( std::size_t t = 0; t < threads; ++t ) {
+			workers.emplace_back( [&, t]() {
+					gate.wait();
+					std::size_t seen = 0;
+					for( ;; ) {
+						std::size_t current;
+						while( (current = generation.load( std::memory_order_acquire )) == seen ) {
+							if( stop.load( std::memory_order_relaxed ) ) {
+								return;
+							}
+							std::this_thread::yield();
+						}
+						seen = current;
+						for( auto& connection : connections[t] ) {
+							connection.disconnect();
+						}
+						finished.fetch_add( 1, std::memory_order_release );
+					}
+				});
+		}
+		bench::histogram latencies;
+		auto const start = gate.open( threads );
+		for( std::size_t i = 0; i < state.iterations(); ++i ) {
+			std::unique_ptr<nod::signal<void()>> signal{ new nod::signal<void()> };
+			for( auto& thread_connections : connections ) {
+				thread_connections.clear();
+				for( std::size_t s = 0; s < slots_per_thread; ++s ) {
+					thread_connections.push_back( signal->connect( [](){} ) );
+				}
+			}
+			generation.store( i+1, std::memory_order_release );
+			auto const destroy_start = bench::clock::now();
+			signal.reset();
+			latencies.record( nanoseconds_between( destroy_start, bench::clock::now() ) );
+			while( finished.load( std::memory_order_acquire ) < threads * (i+1) ) {
+				std::this_thread::yield();
+			}
+		}
+		auto const elapsed = bench::clock::now() - start;
+		stop = true;
+		for( auto& worker : workers ) {
+			worker.join();
+		}
+		report( state, threads, elapsed, latencies, "destroy_" );
+	}
+
+	/// Signal whose emissions don't lock its mutex
+	using seqlock_signal = nod::signal_type<nod::seqlock_policy<>, void(int)>;
+
+	/// Register the benchmarks for all thread counts
+	bool register_benchmarks() {
+		for( auto threads : thread_counts() ) {
+			auto const suffix = "/threads:" + std::to_string( threads );
+			bench::registration{ "mt/emit/signal/8" + suffix, [threads]( bench::state& s ) { emit( s, threads, 8, false ); } };
+			bench::registration{ "mt/emit/signal/64" + suffix, [threads]( bench::state& s ) { emit( s, threads, 64, false ); } };
+			bench::registration{ "mt/emit_with_churn/signal/8" + suffix, [threads]( bench::state& s ) { emit( s, threads, 8, true ); } };
+			bench::registration{ "mt/emit/seqlock/8" + suffix, [threads]( bench::state& s ) { emit<seqlock_signal>( s, threads, 8, false ); } };
+			bench::registration{ "mt/emit/seqlock/64" + suffix, [threads]( bench::state& s ) { emit<seqlock_signal>( s, threads, 64, false ); } };
+			bench::registration{ "mt/emit_with_churn/seqlock/8" + suffix, [threads]( bench::state& s ) { emit<seqlock_signal>( s, threads, 8, true ); } };
+			bench::registration{ "mt/destroy_race/signal" + suffix, [threads]( bench::state& s ) { destroy_race( s, threads ); } };
+		}
+		return true;
+	}
+
+	bool const registered = register_benchmarks();
+
+}	// anonymous namespace
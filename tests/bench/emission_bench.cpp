@@ -0,0 +1,108 @@
+#include "bench.hpp"
+#include <nod/nod.hpp>
+#include <nod/instrument/flight_recorder.hpp>
+
+namespace {
+
+	/// Trigger a signal with a given number of connected slots
+	template <class S>
+	void emit( bench::state& state, std::size_t slots ) {
+		S signal;
+		int sum = 0;
+		for( std::size_t i = 0; i < slots; ++i ) {
+			signal.connect( [&sum]( int x ) { sum += x; } );
+		}
+		int x = 0;
+		while( state.keep_running() ) {
+			signal( ++x );
+		}
+		bench::do_not_optimize( sum );
+	}
+
+	/// Slot adding the signal argument to a sum
+	struct add_slot {
+		int* sum;
+		void operator()( int x ) const { *sum += x; }
+	};
+
+	/// Trigger a homogeneous signal with a given number of connected slots
+	template <class S>
+	void emit_homogeneous( bench::state& state, std::size_t slots ) {
+		S signal;
+		int sum = 0;
+		for( std::size_t i = 0; i < slots; ++i ) {
+			signal.connect( add_slot{ &sum } );
+		}
+		int x = 0;
+		while( state.keep_running() ) {
+			signal( ++x );
+		}
+		bench::do_not_optimize( sum );
+	}
+
+	/// Free function slot for the static signal
+	int static_sum = 0;
+	void add_to_static_sum( int x ) {
+		static_sum += x;
+	}
+
+	/// Trigger a static signal, with its slots fixed at compile time
+	template <class S>
+	void emit_static( bench::state& state ) {
+		S signal;
+		int x = 0;
+		while( state.keep_running() ) {
+			signal( ++x );
+		}
+		bench::do_not_optimize( static_sum );
+	}
+
+	bench::registration emit_signal_0{ "emit/signal/0", []( bench::state& s ) { emit<nod::signal<void(int)>>( s, 0 ); } };
+	bench::registration emit_signal_1{ "emit/signal/1", []( bench::state& s ) { emit<nod::signal<void(int)>>( s, 1 ); } };
+	bench::registration emit_signal_8{ "emit/signal/8", []( bench::state& s ) { emit<nod::signal<void(int)>>( s, 8 ); } };
+	bench::registration emit_signal_64{ "emit/signal/64", []( bench::state& s ) { emit<nod::signal<void(int)>>( s, 64 ); } };
+	bench::registration emit_signal_1024{ "emit/signal/1024", []( bench::state& s ) { emit<nod::signal<void(int)>>( s, 1024 ); } };
+
+	bench::registration emit_unsafe_0{ "emit/unsafe_signal/0", []( bench::state& s ) { emit<nod::unsafe_signal<void(int)>>( s, 0 ); } };
+	bench::registration emit_unsafe_1{ "emit/unsafe_signal/1", []( bench::state& s ) { emit<nod::unsafe_signal<void(int)>>( s, 1 ); } };
+	bench::registration emit_unsafe_8{ "emit/unsafe_signal/8", []( bench::state& s ) { emit<nod::unsafe_signal<void(int)>>( s, 8 ); } };
+	bench::registration emit_unsafe_64{ "emit/unsafe_signal/64", []( bench::state& s ) { emit<nod::unsafe_signal<void(int)>>( s, 64 ); } };
+	bench::registration emit_unsafe_1024{ "emit/unsafe_signal/1024", []( bench::state& s ) { emit<nod::unsafe_signal<void(int)>>( s, 1024 ); } };
+
+	bench::registration emit_homogeneous_1{ "emit/homogeneous_signal/1", []( bench::state& s ) { emit_homogeneous<nod::homogeneous_signal<add_slot, void(int)>>( s, 1 ); } };
+	bench::registration emit_homogeneous_8{ "emit/homogeneous_signal/8", []( bench::state& s ) { emit_homogeneous<nod::homogeneous_signal<add_slot, void(int)>>( s, 8 ); } };
+	bench::registration emit_homogeneous_64{ "emit/homogeneous_signal/64", []( bench::state& s ) { emit_homogeneous<nod::homogeneous_signal<add_slot, void(int)>>( s, 64 ); } };
+	bench::registration emit_homogeneous_1024{ "emit/homogeneous_signal/1024", []( bench::state& s ) { emit_homogeneous<nod::homogeneous_signal<add_slot, void(int)>>( s, 1024 ); } };
+
+	bench::registration emit_unsafe_homogeneous_1{ "emit/unsafe_homogeneous_signal/1", []( bench::state& s ) { emit_homogeneous<nod::unsafe_homogeneous_signal<add_slot, void(int)>>( s, 1 ); } };
+	bench::registration emit_unsafe_homogeneous_8{ "emit/unsafe_homogeneous_signal/8", []( bench::state& s ) { emit_homogeneous<nod::unsafe_homogeneous_signal<add_slot, void(int)>>( s, 8 ); } };
+	bench::registration emit_unsafe_homogeneous_64{ "emit/unsafe_homogeneous_signal/64", []( bench::state& s ) { emit_homogeneous<nod::unsafe_homogeneous_signal<add_slot, void(int)>>( s, 64 ); } };
+	bench::registration emit_unsafe_homogeneous_1024{ "emit/unsafe_homogeneous_signal/1024", []( bench::state& s ) { emit_homogeneous<nod::unsafe_homogeneous_signal<add_slot, void(int)>>( s, 1024 ); } };
+
+	bench::registration emit_static_1{ "emit/static_signal/1", []( bench::state& s ) { emit_static<nod::static_signal<void(int), &add_to_static_sum>>( s ); } };
+	bench::registration emit_static_8{ "emit/static_signal/8", []( bench::state& s ) {
+		emit_static<nod::static_signal<void(int),
+			&add_to_static_sum, &add_to_static_sum, &add_to_static_sum, &add_to_static_sum,
+			&add_to_static_sum, &add_to_static_sum, &add_to_static_sum, &add_to_static_sum>>( s );
+	} };
+
+	// Slot snapshots taken from the per thread cache of the slot pool
+	bench::registration emit_slot_pool_1{ "emit/slot_pool/1", []( bench::state& s ) { emit<nod::signal_type<nod::slot_pool_policy<>, void(int)>>( s, 1 ); } };
+	bench::registration emit_slot_pool_8{ "emit/slot_pool/8", []( bench::state& s ) { emit<nod::signal_type<nod::slot_pool_policy<>, void(int)>>( s, 8 ); } };
+	bench::registration emit_slot_pool_64{ "emit/slot_pool/64", []( bench::state& s ) { emit<nod::signal_type<nod::slot_pool_policy<>, void(int)>>( s, 64 ); } };
+
+	// Slots shared between emissions instead of copied by each emission
+	bench::registration emit_shared_8{ "emit/shared_slots/8", []( bench::state& s ) { emit<nod::signal_type<nod::shared_slots_policy<>, void(int)>>( s, 8 ); } };
+	bench::registration emit_shared_64{ "emit/shared_slots/64", []( bench::state& s ) { emit<nod::signal_type<nod::shared_slots_policy<>, void(int)>>( s, 64 ); } };
+	bench::registration emit_shared_1024{ "emit/shared_slots/1024", []( bench::state& s ) { emit<nod::signal_type<nod::shared_slots_policy<>, void(int)>>( s, 1024 ); } };
+
+	// Slots stored in a persistent vector
+	bench::registration emit_persistent_8{ "emit/persistent_slots/8", []( bench::state& s ) { emit<nod::signal_type<nod::persistent_slots_policy<>, void(int)>>( s, 8 ); } };
+	bench::registration emit_persistent_64{ "emit/persistent_slots/64", []( bench::state& s ) { emit<nod::signal_type<nod::persistent_slots_policy<>, void(int)>>( s, 64 ); } };
+	bench::registration emit_persistent_1024{ "emit/persistent_slots/1024", []( bench::state& s ) { emit<nod::signal_type<nod::persistent_slots_policy<>, void(int)>>( s, 1024 ); } };
+
+	// Overhead of keeping the flight recorder enabled
+	bench::registration emit_flight_recorder_1{ "emit/flight_recorder/1", []( bench::state& s ) { emit<nod::signal_type<nod::flight_recorder_policy<>, void(int)>>( s, 1 ); } };
+	bench::registration emit_flight_recorder_8{ "emit/flight_recorder/8", []( bench::state& s ) { emit<nod::signal_type<nod::flight_recorder_policy<>, void(int)>>( s, 8 ); } };
+
+}	// anonymous namespace
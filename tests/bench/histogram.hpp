@@ -0,0 +1,112 @@
+#ifndef IG_BENCH_HISTOGRAM_HPP
+#define IG_BENCH_HISTOGRAM_HPP
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <vector>       // std::vector
+
+namespace bench
+{
+	/// Log-linear latency histogram, in the style of HdrHistogram.
+	///
+	/// Values below `2^precision_bits` are recorded exactly. Larger values
+	/// are recorded in buckets whose width grows with the magnitude of the
+	/// value, keeping the relative error below `2^-(precision_bits-1)`.
+	/// Recording is a few arithmetic operations and a increment, so each
+	/// thread can record into its own histogram and the histograms can be
+	/// merged when the measurement is done.
+	class histogram
+	{
+		public:
+			/// Number of bits of precision of the recorded values.
+			static constexpr unsigned precision_bits = 7;
+
+			histogram() :
+				_counts( sub_buckets + (64 - precision_bits) * half_sub_buckets ),
+				_total( 0 )
+			{}
+
+			/// Record a value
+			void record( std::uint64_t value ) {
+				++_counts[ index_of( value ) ];
+				++_total;
+			}
+
+			/// Add all values recorded in another histogram
+			void merge( histogram const& other ) {
+				for( std::size_t i = 0; i < _counts.size(); ++i ) {
+					_counts[i] += other._counts[i];
+				}
+				_total += other._total;
+			}
+
+			/// @returns The number of recorded values
+			std::uint64_t count() const {
+				return _total;
+			}
+
+			/// @param percentile   Percentile in the range [0, 100].
+			/// @returns            The value at the given percentile, or
+			///                     zero if no values are recorded.
+			std::uint64_t percentile( double percentile ) const {
+				if( _total == 0 ) {
+					return 0;
+				}
+				auto target = static_cast<std::uint64_t>( percentile / 100.0 * _total + 0.5 );
+				target = target == 0 ? 1 : (target > _total ? _total : target);
+				std::uint64_t seen = 0;
+				for( std::size_t i = 0; i < _counts.size(); ++i ) {
+					seen += _counts[i];
+					if( seen >= target ) {
+						return highest_value_of( i );
+					}
+				}
+				return highest_value_of( _counts.size() - 1 );
+			}
+
+		private:
+			static constexpr std::uint64_t sub_buckets = std::uint64_t{1} << precision_bits;
+			static constexpr std::uint64_t half_sub_buckets = sub_buckets / 2;
+
+			/// @returns The index of the most significant set bit
+			static unsigned most_significant_bit( std::uint64_t value ) {
+#if defined(__GNUC__) || defined(__clang__)
+				return 63 - static_cast<unsigned>( __builtin_clzll( value ) );
+#else
+				unsigned bit = 0;
+				while( value >>= 1 ) {
+					++bit;
+				}
+				return bit;
+#endif
+			}
+
+			/// @returns The bucket index of a value
+			static std::size_t index_of( std::uint64_t value ) {
+				if( value < sub_buckets ) {
+					return static_cast<std::size_t>( value );
+				}
+				unsigned const shift = most_significant_bit( value ) - precision_bits + 1;
+				std::uint64_t const sub = value >> shift;
+				return static_cast<std::size_t>( sub_buckets + (shift - 1) * half_sub_buckets + (sub - half_sub_buckets) );
+			}
+
+			/// @returns The highest value that is recorded in a bucket
+			static std::uint64_t highest_value_of( std::size_t index ) {
+				if( index < sub_buckets ) {
+					return index;
+				}
+				std::size_t const shift = (index - sub_buckets) / half_sub_buckets + 1;
+				std::uint64_t const sub = (index - sub_buckets) % half_sub_buckets + half_sub_buckets;
+				return ((sub + 1) << shift) - 1;
+			}
+
+			/// Number of values recorded in each bucket
+			std::vector<std::uint64_t> _counts;
+			/// Total number of recorded values
+			std::uint64_t _total;
+	};
+
+}	// namespace bench
+
+#endif // IG_BENCH_HISTOGRAM_HPP
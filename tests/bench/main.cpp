@@ -0,0 +1,242 @@
+#include "bench.hpp"
+
+#include <algorithm>    // std::sort
+#include <cmath>        // std::sqrt
+#include <cstdlib>      // std::strtoul
+#include <cstring>      // std::strncmp
+#include <ctime>        // std::time, std::strftime
+#include <fstream>      // std::ofstream
+#include <iostream>     // std::cout, std::cerr
+#include <numeric>      // std::accumulate
+#include <sstream>      // std::ostringstream
+
+namespace {
+
+	/// Options given on the command line
+	struct options
+	{
+		std::string filter;
+		std::string out;
+		std::size_t repetitions = 10;
+		std::chrono::milliseconds min_time{ 20 };
+		bool list = false;
+	};
+
+	/// Measured result of a benchmark
+	struct result
+	{
+		std::string name;
+		std::size_t iterations;
+		std::vector<double> samples;
+		/// Counters reported by the benchmark, with one value per sample
+		std::vector<std::pair<std::string,std::vector<double>>> counters;
+	};
+
+	void print_usage( char const* program ) {
+		std::cerr
+			<< "Usage: " << program << " [options]\n"
+			<< "  --filter=<text>      Only run benchmarks with names containing <text>\n"
+			<< "  --repetitions=<n>    Number of samples taken of each benchmark (default 10)\n"
+			<< "  --min-time=<ms>      Minimum duration of each sample in milliseconds (default 20)\n"
+			<< "  --out=<file>         Write the JSON result to <file> instead of stdout\n"
+			<< "  --list               List the names of the benchmarks\n";
+	}
+
+	/// Match a command line argument of the form `--name=value`
+	bool match( char const* arg, char const* name, std::string& value ) {
+		auto length = std::strlen( name );
+		if( std::strncmp( arg, name, length ) == 0 && arg[length] == '=' ) {
+			value = arg + length + 1;
+			return true;
+		}
+		return false;
+	}
+
+	bool parse( int argc, char** argv, options& opts ) {
+		for( int i = 1; i < argc; ++i ) {
+			std::string value;
+			if( match( argv[i], "--filter", value ) ) {
+				opts.filter = value;
+			}
+			else if( match( argv[i], "--out", value ) ) {
+				opts.out = value;
+			}
+			else if( match( argv[i], "--repetitions", value ) ) {
+				opts.repetitions = std::max<std::size_t>( std::strtoul( value.c_str(), nullptr, 10 ), 1 );
+			}
+			else if( match( argv[i], "--min-time", value ) ) {
+				opts.min_time = std::chrono::milliseconds{ std::strtoul( value.c_str(), nullptr, 10 ) };
+			}
+			else if( std::string{ argv[i] } == "--list" ) {
+				opts.list = true;
+			}
+			else {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// Run a benchmark a given number of iterations
+	/// @returns The state of the finished benchmark
+	bench::state run_state( bench::benchmark const& b, std::size_t iterations ) {
+		bench::state state{ iterations };
+		b.func( state );
+		return state;
+	}
+
+	/// Run a benchmark a given number of iterations
+	/// @returns The time spent in the benchmark loop
+	bench::clock::duration run( bench::benchmark const& b, std::size_t iterations ) {
+		return run_state( b, iterations ).elapsed();
+	}
+
+	/// @returns The median of a set of values
+	double median( std::vector<double> values ) {
+		std::sort( values.begin(), values.end() );
+		return values.size() % 2 != 0 ?
+			values[values.size()/2] :
+			(values[values.size()/2 - 1] + values[values.size()/2]) / 2.0;
+	}
+
+	/// Find the number of iterations needed for a sample to take
+	/// at least the minimum time.
+	std::size_t calibrate( bench::benchmark const& b, bench::clock::duration min_time ) {
+		std::size_t iterations = 1;
+		for( ;; ) {
+			auto elapsed = run( b, iterations );
+			if( elapsed >= min_time || iterations >= (std::size_t{1} << 40) ) {
+				return iterations;
+			}
+			// Aim a bit past the minimum time, but grow at most 10x per step.
+			double const ratio = elapsed.count() > 0 ? 1.4 * min_time.count() / elapsed.count() : 10.0;
+			iterations = static_cast<std::size_t>( iterations * std::min( std::max( ratio, 2.0 ), 10.0 ) );
+		}
+	}
+
+	result measure( bench::benchmark const& b, options const& opts ) {
+		result r;
+		r.name = b.name;
+		r.iterations = calibrate( b, opts.min_time );
+		for( std::size_t i = 0; i < opts.repetitions; ++i ) {
+			auto state = run_state( b, r.iterations );
+			auto elapsed = std::chrono::duration_cast<std::chrono::duration<double,std::nano>>( state.elapsed() );
+			r.samples.push_back( elapsed.count() / r.iterations );
+			for( auto const& counter : state.counters() ) {
+				auto it = std::find_if( r.counters.begin(), r.counters.end(), [&]( std::pair<std::string,std::vector<double>> const& c ) {
+						return c.first == counter.first;
+					});
+				if( it == r.counters.end() ) {
+					r.counters.emplace_back( counter.first, std::vector<double>{} );
+					it = r.counters.end() - 1;
+				}
+				it->second.push_back( counter.second );
+			}
+		}
+		return r;
+	}
+
+	std::string escape( std::string const& str ) {
+		std::string escaped;
+		for( auto c : str ) {
+			if( c == '"' || c == '\\' ) {
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	void write_json( std::ostream& out, std::vector<result> const& results, options const& opts ) {
+		char date[32];
+		std::time_t now = std::time( nullptr );
+		std::strftime( date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime( &now ) );
+		out.precision( 6 );
+		out << std::fixed;
+		out << "{\n";
+		out << "  \"context\": {\n";
+		out << "    \"library\": \"nod\",\n";
+		out << "    \"date\": \"" << date << "\",\n";
+#if defined(__VERSION__)
+		out << "    \"compiler\": \"" << escape( __VERSION__ ) << "\",\n";
+#endif
+		out << "    \"repetitions\": " << opts.repetitions << ",\n";
+		out << "    \"unit\": \"ns/op\"\n";
+		out << "  },\n";
+		out << "  \"benchmarks\": [";
+		for( std::size_t i = 0; i < results.size(); ++i ) {
+			auto const& r = results[i];
+			auto sorted = r.samples;
+			std::sort( sorted.begin(), sorted.end() );
+			double const mean = std::accumulate( sorted.begin(), sorted.end(), 0.0 ) / sorted.size();
+			double variance = 0.0;
+			for( auto sample : sorted ) {
+				variance += (sample - mean) * (sample - mean);
+			}
+			variance = sorted.size() > 1 ? variance / (sorted.size() - 1) : 0.0;
+			out << (i == 0 ? "\n" : ",\n");
+			out << "    {\n";
+			out << "      \"name\": \"" << escape( r.name ) << "\",\n";
+			out << "      \"iterations\": " << r.iterations << ",\n";
+			out << "      \"mean\": " << mean << ",\n";
+			out << "      \"median\": " << median( r.samples ) << ",\n";
+			out << "      \"stddev\": " << std::sqrt( variance ) << ",\n";
+			out << "      \"min\": " << sorted.front() << ",\n";
+			out << "      \"max\": " << sorted.back() << ",\n";
+			out << "      \"samples\": [";
+			for( std::size_t j = 0; j < r.samples.size(); ++j ) {
+				out << (j == 0 ? "" : ", ") << r.samples[j];
+			}
+			out << "]";
+			if( !r.counters.empty() ) {
+				// Counters are reported as the median over all samples
+				out << ",\n      \"counters\": {";
+				for( std::size_t j = 0; j < r.counters.size(); ++j ) {
+					out << (j == 0 ? "\n" : ",\n");
+					out << "        \"" << escape( r.counters[j].first ) << "\": " << median( r.counters[j].second );
+				}
+				out << "\n      }";
+			}
+			out << "\n    }";
+		}
+		out << "\n  ]\n";
+		out << "}\n";
+	}
+
+}	// anonymous namespace
+
+int main( int argc, char** argv ) {
+	options opts;
+	if( !parse( argc, argv, opts ) ) {
+		print_usage( argv[0] );
+		return 1;
+	}
+	std::vector<result> results;
+	for( auto const& b : bench::registry() ) {
+		if( b.name.find( opts.filter ) == std::string::npos ) {
+			continue;
+		}
+		if( opts.list ) {
+			std::cout << b.name << "\n";
+			continue;
+		}
+		std::cerr << b.name << "..." << std::flush;
+		results.push_back( measure( b, opts ) );
+		std::cerr << " " << results.back().samples.front() << " ns/op\n";
+	}
+	if( opts.list ) {
+		return 0;
+	}
+	if( opts.out.empty() ) {
+		write_json( std::cout, results, opts );
+	}
+	else {
+		std::ofstream file{ opts.out };
+		write_json( file, results, opts );
+		if( !file ) {
+			std::cerr << "Unable to write " << opts.out << "\n";
+			return 1;
+		}
+	}
+	return 0;
+}
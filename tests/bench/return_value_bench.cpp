@@ -0,0 +1,124 @@
+#include "bench.hpp"
+#include <nod/nod.hpp>
+#include <nod/parallel.hpp>
+
+#include <string>       // std::to_string
+
+namespace {
+
+	/// Connect a given number of slots returning a value
+	template <class S>
+	void connect_slots( S& signal, std::size_t slots ) {
+		for( std::size_t i = 0; i < slots; ++i ) {
+			int const factor = static_cast<int>( i );
+			signal.connect( [factor]( int x ) { return factor * x; } );
+		}
+	}
+
+	template <class S>
+	void accumulate( bench::state& state, std::size_t slots ) {
+		S signal;
+		connect_slots( signal, slots );
+		auto accumulator = signal.accumulate( 0, std::plus<int>{} );
+		int x = 0;
+		while( state.keep_running() ) {
+			bench::do_not_optimize( accumulator( x++ ) );
+		}
+	}
+
+	template <class S>
+	void accumulate_vector( bench::state& state, std::size_t slots ) {
+		S signal;
+		connect_slots( signal, slots );
+		auto accumulator = signal.accumulate( std::vector<int>{}, []( std::vector<int> v, int x ) {
+				v.push_back( x );
+				return v;
+			});
+		int x = 0;
+		while( state.keep_running() ) {
+			bench::do_not_optimize( accumulator( x++ ).size() );
+		}
+	}
+
+	template <class S>
+	void accumulate_in_place( bench::state& state, std::size_t slots ) {
+		S signal;
+		connect_slots( signal, slots );
+		auto accumulator = signal.accumulate_in_place( std::vector<int>{}, []( std::vector<int>& v, int x ) {
+				v.push_back( x );
+			});
+		int x = 0;
+		while( state.keep_running() ) {
+			bench::do_not_optimize( accumulator( ++x ).size() );
+		}
+	}
+
+	template <class S>
+	void aggregate( bench::state& state, std::size_t slots ) {
+		S signal;
+		connect_slots( signal, slots );
+		int x = 0;
+		while( state.keep_running() ) {
+			bench::do_not_optimize( signal.template aggregate<std::vector<int>>( ++x ).size() );
+		}
+	}
+
+	template <class S>
+	void aggregate_into( bench::state& state, std::size_t slots ) {
+		S signal;
+		connect_slots( signal, slots );
+		std::vector<int> results;
+		int x = 0;
+		while( state.keep_running() ) {
+			bench::do_not_optimize( signal.aggregate_into( results, ++x ) );
+		}
+	}
+
+	/// Accumulate in parallel, with each thread calling at least a given
+	/// number of slots. With a minimum of 1, every emission hands chunks
+	/// to the worker pool, which compared with `accumulate` on the same
+	/// number of slots shows where the handoff starts to pay off.
+	template <class S>
+	void accumulate_parallel( bench::state& state, std::size_t slots, std::size_t min_slots_per_worker ) {
+		S signal;
+		connect_slots( signal, slots );
+		auto accumulator = signal.accumulate_parallel( 0, std::plus<int>{}, 0, min_slots_per_worker );
+		int x = 0;
+		while( state.keep_running() ) {
+			bench::do_not_optimize( accumulator( ++x ) );
+		}
+	}
+
+	using int_signal = nod::signal<int(int)>;
+	using unsafe_int_signal = nod::unsafe_signal<int(int)>;
+
+	bench::registration accumulate_8{ "accumulate/signal/8", []( bench::state& s ) { accumulate<int_signal>( s, 8 ); } };
+	bench::registration accumulate_64{ "accumulate/signal/64", []( bench::state& s ) { accumulate<int_signal>( s, 64 ); } };
+	bench::registration accumulate_unsafe_64{ "accumulate/unsafe_signal/64", []( bench::state& s ) { accumulate<unsafe_int_signal>( s, 64 ); } };
+	bench::registration accumulate_vector_8{ "accumulate_vector/signal/8", []( bench::state& s ) { accumulate_vector<int_signal>( s, 8 ); } };
+	bench::registration accumulate_vector_64{ "accumulate_vector/signal/64", []( bench::state& s ) { accumulate_vector<int_signal>( s, 64 ); } };
+	bench::registration accumulate_in_place_8{ "accumulate_in_place/signal/8", []( bench::state& s ) { accumulate_in_place<int_signal>( s, 8 ); } };
+	bench::registration accumulate_in_place_64{ "accumulate_in_place/signal/64", []( bench::state& s ) { accumulate_in_place<int_signal>( s, 64 ); } };
+	bench::registration aggregate_8{ "aggregate/signal/8", []( bench::state& s ) { aggregate<int_signal>( s, 8 ); } };
+	bench::registration aggregate_64{ "aggregate/signal/64", []( bench::state& s ) { aggregate<int_signal>( s, 64 ); } };
+	bench::registration aggregate_unsafe_64{ "aggregate/unsafe_signal/64", []( bench::state& s ) { aggregate<unsafe_int_signal>( s, 64 ); } };
+	bench::registration aggregate_into_8{ "aggregate_into/signal/8", []( bench::state& s ) { aggregate_into<int_signal>( s, 8 ); } };
+	bench::registration aggregate_into_64{ "aggregate_into/signal/64", []( bench::state& s ) { aggregate_into<int_signal>( s, 64 ); } };
+
+	/// Register the sequential and parallel accumulation of growing numbers
+	/// of slots, to find the crossover point of parallel accumulation.
+	bool register_crossover() {
+		for( std::size_t slots : { 64, 300, 1024, 4096, 16384, 65536 } ) {
+			auto const suffix = "/" + std::to_string( slots );
+			bench::registration{ "crossover/accumulate" + suffix, [slots]( bench::state& s ) { accumulate<int_signal>( s, slots ); } };
+			bench::registration{ "crossover/accumulate_parallel" + suffix, [slots]( bench::state& s ) {
+					accumulate_parallel<int_signal>( s, slots, int_signal::default_min_slots_per_worker );
+				} };
+			bench::registration{ "crossover/accumulate_parallel_all_workers" + suffix, [slots]( bench::state& s ) { accumulate_parallel<int_signal>( s, slots, 1 ); } };
+		}
+		return true;
+	}
+
+	bool const crossover_registered = register_crossover();
+
+}	// anonymous namespace
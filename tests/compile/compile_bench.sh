@@ -0,0 +1,72 @@
+#!/bin/sh
+# Compile time and code size benchmark of signal instantiations.
+#
+# Generates a translation unit using N distinct signal signatures, each
+# connected, triggered and disconnected, and measures the time to compile
+# it, the size of the object file and the size of its text section.
+#
+# Usage: compile_bench.sh [N...]
+# The compiler and flags are taken from CXX and CXXFLAGS, which default to
+# c++ and "-std=c++11 -O2".
+#
+# Requires GNU date, for time stamps in nanoseconds with %N, and GNU size
+# from binutils, for the sections of the object file with -A. The script
+# stops with an error if they aren't available, like on macOS without
+# coreutils and binutils installed.
+
+set -e
+
+CXX=${CXX:-c++}
+CXXFLAGS=${CXXFLAGS:--std=c++11 -O2}
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Generate a translation unit with a given number of signatures
+generate() {
+	n=$1
+	file=$2
+	{
+		echo "#include <nod/nod.hpp>"
+		echo "int sum = 0;"
+		i=0
+		while [ "$i" -lt "$n" ]; do
+			echo "struct arg$i { int value; };"
+			echo "void use$i() {"
+			echo "	nod::signal<void(arg$i const&)> signal;"
+			echo "	auto connection = signal.connect( []( arg$i const& a ) { sum += a.value; } );"
+			echo "	signal( arg$i{ $i } );"
+			echo "	connection.disconnect();"
+			echo "}"
+			i=$((i+1))
+		done
+	} > "$file"
+}
+
+# Current time in nanoseconds
+now() {
+	date +%s%N
+}
+
+# Stop with a error message
+fail() {
+	echo "compile_bench.sh: $*" >&2
+	exit 1
+}
+
+case $(date +%N) in
+	''|*[!0-9]*) fail "date doesn't support %N, GNU date is required" ;;
+esac
+
+echo "signatures  compile_ms  object_bytes  text_bytes  text_bytes_per_signature"
+for n in ${@:-1 10 100}; do
+	generate "$n" "$WORK/signals_$n.cpp"
+	start=$(now)
+	$CXX $CXXFLAGS -I"$ROOT/include" -c "$WORK/signals_$n.cpp" -o "$WORK/signals_$n.o"
+	stop=$(now)
+	object=$(wc -c < "$WORK/signals_$n.o")
+	sections=$(size -A "$WORK/signals_$n.o" 2>/dev/null) ||
+		fail "size doesn't support -A, GNU size is required"
+	text=$(echo "$sections" | awk '$1 ~ /^\.text/ { sum += $2 } END { print sum }')
+	printf "%10d  %10d  %12d  %10d  %24d\n" "$n" $(( (stop - start) / 1000000 )) "$object" "$text" $(( text / n ))
+done
@@ -0,0 +1,81 @@
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+	using pmr_policy = nod::allocator_policy<std::pmr::polymorphic_allocator<char>>;
+
+	/// Memory resource counting the allocations made from it
+	class counting_resource : public std::pmr::memory_resource {
+		public:
+			std::size_t allocations = 0;
+
+		private:
+			void* do_allocate( std::size_t bytes, std::size_t alignment ) override {
+				++allocations;
+				return std::pmr::new_delete_resource()->allocate( bytes, alignment );
+			}
+
+			void do_deallocate( void* ptr, std::size_t bytes, std::size_t alignment ) override {
+				std::pmr::new_delete_resource()->deallocate( ptr, bytes, alignment );
+			}
+
+			bool do_is_equal( std::pmr::memory_resource const& other ) const noexcept override {
+				return this == &other;
+			}
+	};
+
+	int twice( int x ) {
+		return x * 2;
+	}
+}
+
+SCENARIO( "Signals allocate from polymorphic memory resources" ) {
+	GIVEN( "a signal using a counting memory resource" ) {
+		counting_resource resource;
+		nod::signal_type<pmr_policy, int(int)> signal{ &resource };
+		signal.connect( &twice );
+		THEN( "the slot storage is allocated from the resource" ) {
+			REQUIRE( resource.allocations > 0 );
+			REQUIRE( signal.accumulate( 0, std::plus<int>{} )( 21 ) == 42 );
+		}
+	}
+	GIVEN( "a homogeneous signal using a counting memory resource" ) {
+		counting_resource resource;
+		nod::homogeneous_signal_type<pmr_policy, int(*)(int), int(int)> signal{ &resource };
+		signal.connect( &twice );
+		signal.connect( &twice );
+		THEN( "the slot storage is allocated from the resource" ) {
+			REQUIRE( resource.allocations > 0 );
+			REQUIRE( signal.accumulate( 0, std::plus<int>{} )( 21 ) == 84 );
+		}
+	}
+	GIVEN( "a homogeneous signal with a slot disconnecting itself" ) {
+		counting_resource resource;
+		nod::homogeneous_signal_type<pmr_policy, std::function<void()>, void()> signal{ &resource };
+		nod::connection connection;
+		int calls = 0;
+		connection = signal.connect( std::function<void()>{ [&](){ ++calls; connection.disconnect(); } } );
+		WHEN( "we trigger the signal" ) {
+			signal();
+			signal();
+			THEN( "the slot storage is copied with the resource while the signal is triggered" ) {
+				REQUIRE( calls == 1 );
+				REQUIRE( signal.empty() );
+			}
+		}
+	}
+	GIVEN( "a unsafe homogeneous signal using a counting memory resource" ) {
+		counting_resource resource;
+		nod::homogeneous_signal_type<nod::allocator_policy<std::pmr::polymorphic_allocator<char>, nod::singlethread_policy>, int(*)(int), int(int)> signal{ &resource };
+		signal.connect( &twice );
+		THEN( "the slot storage is allocated from the resource" ) {
+			REQUIRE( resource.allocations > 0 );
+			REQUIRE( signal.accumulate( 0, std::plus<int>{} )( 21 ) == 42 );
+		}
+	}
+}
@@ -0,0 +1,339 @@
+// Memory footprint benchmark.
+//
+// Creates large numbers of signals and connections in several shapes, and
+// reports the resident set size, the heap bytes per signal and connection,
+// and the number of allocations. The global allocation functions are
+// replaced by counting versions for the whole executable.
+
+#include <nod/nod.hpp>
+
+#include <algorithm>    // std::max
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::max_align_t
+#include <cstdio>       // std::FILE, std::fopen
+#include <cstdlib>      // std::malloc, std::free, std::strtoul
+#include <cstring>      // std::strncmp
+#include <ctime>        // std::time, std::strftime
+#include <fstream>      // std::ofstream
+#include <iostream>     // std::cout, std::cerr
+#include <new>          // std::bad_alloc
+#include <random>       // std::mt19937
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+#if defined(__linux__)
+#include <unistd.h>     // sysconf
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>     // malloc_trim
+#endif
+
+namespace {
+	/// Heap usage of the process, maintained by the allocation functions
+	struct heap_counters
+	{
+		std::atomic<std::size_t> allocations{ 0 };
+		std::atomic<std::size_t> live_bytes{ 0 };
+	};
+
+	heap_counters heap;
+
+	/// Space reserved in front of each allocation for its size, keeping
+	/// the alignment of the returned pointer.
+	std::size_t const header_size = alignof( std::max_align_t ) > sizeof( std::size_t ) ?
+		alignof( std::max_align_t ) : sizeof( std::size_t );
+
+	void* counted_allocation( std::size_t size ) {
+		auto* ptr = static_cast<char*>( std::malloc( size + header_size ) );
+		if( ptr == nullptr ) {
+			throw std::bad_alloc{};
+		}
+		*reinterpret_cast<std::size_t*>( ptr ) = size;
+		heap.allocations.fetch_add( 1, std::memory_order_relaxed );
+		heap.live_bytes.fetch_add( size, std::memory_order_relaxed );
+		return ptr + header_size;
+	}
+
+	void counted_free( void* ptr ) {
+		if( ptr != nullptr ) {
+			auto* base = static_cast<char*>( ptr ) - header_size;
+			heap.live_bytes.fetch_sub( *reinterpret_cast<std::size_t*>( base ), std::memory_order_relaxed );
+			std::free( base );
+		}
+	}
+}	// anonymous namespace
+
+void* operator new( std::size_t size ) {
+	return counted_allocation( size );
+}
+
+void* operator new[]( std::size_t size ) {
+	return counted_allocation( size );
+}
+
+void operator delete( void* ptr ) noexcept {
+	counted_free( ptr );
+}
+
+void operator delete[]( void* ptr ) noexcept {
+	counted_free( ptr );
+}
+
+namespace {
+
+	/// Options given on the command line
+	struct options
+	{
+		std::size_t signals = 1000000;
+		std::size_t connections = 10000000;
+		std::string out;
+	};
+
+	void print_usage( char const* program ) {
+		std::cerr
+			<< "Usage: " << program << " [options]\n"
+			<< "  --signals=<n>        Number of signals in the many signals shapes (default 1000000)\n"
+			<< "  --connections=<n>    Number of connections in the many slots and churn shapes (default 10000000)\n"
+			<< "  --out=<file>         Write the JSON result to <file> instead of stdout\n";
+	}
+
+	/// Match a command line argument of the form `--name=value`
+	bool match( char const* arg, char const* name, std::string& value ) {
+		auto length = std::strlen( name );
+		if( std::strncmp( arg, name, length ) == 0 && arg[length] == '=' ) {
+			value = arg + length + 1;
+			return true;
+		}
+		return false;
+	}
+
+	bool parse( int argc, char** argv, options& opts ) {
+		for( int i = 1; i < argc; ++i ) {
+			std::string value;
+			if( match( argv[i], "--signals", value ) ) {
+				opts.signals = std::max<std::size_t>( std::strtoul( value.c_str(), nullptr, 10 ), 1 );
+			}
+			else if( match( argv[i], "--connections", value ) ) {
+				opts.connections = std::max<std::size_t>( std::strtoul( value.c_str(), nullptr, 10 ), 1 );
+			}
+			else if( match( argv[i], "--out", value ) ) {
+				opts.out = value;
+			}
+			else {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// @returns The resident set size of the process in bytes, or 0 if
+	///          it can't be measured on this platform.
+	std::size_t resident_bytes() {
+#if defined(__linux__)
+		std::size_t pages = 0, resident = 0;
+		if( std::FILE* file = std::fopen( "/proc/self/statm", "r" ) ) {
+			if( std::fscanf( file, "%zu %zu", &pages, &resident ) != 2 ) {
+				resident = 0;
+			}
+			std::fclose( file );
+		}
+		return resident * static_cast<std::size_t>( sysconf( _SC_PAGESIZE ) );
+#else
+		return 0;
+#endif
+	}
+
+	/// Return freed memory to the operating system, so that the resident
+	/// set size of a shape isn't hidden by memory freed by the previous one.
+	void release_free_memory() {
+#if defined(__GLIBC__)
+		malloc_trim( 0 );
+#endif
+	}
+
+	/// Measured footprint of a shape
+	struct result
+	{
+		std::string name;
+		std::size_t signals;
+		std::size_t connections;
+		std::size_t heap_bytes;
+		std::size_t rss_bytes;
+		std::size_t allocations;
+		/// Heap bytes per signal, including the signal objects
+		double bytes_per_signal;
+		/// Heap bytes per connection, including the connection objects
+		/// kept by the user, excluding the footprint of empty signals.
+		double bytes_per_connection;
+	};
+
+	/// Measurement of the heap and resident set growth of a shape
+	class measurement
+	{
+		public:
+			measurement() :
+				_heap( heap.live_bytes.load() ),
+				_allocations( heap.allocations.load() ),
+				_rss( resident_bytes() )
+			{}
+
+			/// @returns The result, while the objects of the shape are alive
+			result finish( std::string name, std::size_t signals, std::size_t connections, double empty_signal_bytes ) const {
+				result r;
+				r.name = std::move( name );
+				r.signals = signals;
+				r.connections = connections;
+				r.heap_bytes = heap.live_bytes.load() - _heap;
+				auto rss = resident_bytes();
+				r.rss_bytes = rss > _rss ? rss - _rss : 0;
+				r.allocations = heap.allocations.load() - _allocations;
+				r.bytes_per_signal = static_cast<double>( r.heap_bytes ) / signals;
+				r.bytes_per_connection = connections > 0 ?
+					( r.heap_bytes - empty_signal_bytes * signals ) / connections :
+					0.0;
+				return r;
+			}
+
+		private:
+			std::size_t _heap;
+			std::size_t _allocations;
+			std::size_t _rss;
+	};
+
+	using signal_type = nod::signal<void(int)>;
+
+	/// Slot without captured state, that is stored in a std::function
+	/// without allocating.
+	void slot( int ) {
+	}
+
+	/// Signals without any connected slots
+	result empty_signals( std::size_t signals ) {
+		release_free_memory();
+		measurement m;
+		std::unique_ptr<signal_type[]> s{ new signal_type[signals] };
+		return m.finish( "empty_signals", signals, 0, 0.0 );
+	}
+
+	/// Many signals, each with a single connected slot
+	result many_signals_one_slot( std::size_t signals, double empty_signal_bytes ) {
+		release_free_memory();
+		measurement m;
+		std::unique_ptr<signal_type[]> s{ new signal_type[signals] };
+		std::vector<nod::connection> connections;
+		connections.reserve( signals );
+		for( std::size_t i = 0; i < signals; ++i ) {
+			connections.push_back( s[i].connect( slot ) );
+		}
+		return m.finish( "many_signals_one_slot", signals, signals, empty_signal_bytes );
+	}
+
+	/// Few signals, sharing a large number of connected slots
+	result few_signals_many_slots( std::size_t signals, std::size_t count, double empty_signal_bytes ) {
+		release_free_memory();
+		measurement m;
+		std::unique_ptr<signal_type[]> s{ new signal_type[signals] };
+		std::vector<nod::connection> connections;
+		connections.reserve( count );
+		for( std::size_t i = 0; i < count; ++i ) {
+			connections.push_back( s[i % signals].connect( slot ) );
+		}
+		return m.finish( "few_signals_many_slots", signals, count, empty_signal_bytes );
+	}
+
+	/// Signals with connections that are continuously replaced, as many
+	/// times as there are connections, leaving disconnected slots behind.
+	result churn( std::size_t signals, std::size_t count, double empty_signal_bytes ) {
+		release_free_memory();
+		measurement m;
+		std::unique_ptr<signal_type[]> s{ new signal_type[signals] };
+		std::vector<nod::connection> connections;
+		std::vector<std::size_t> owner;
+		connections.reserve( count );
+		owner.reserve( count );
+		for( std::size_t i = 0; i < count; ++i ) {
+			connections.push_back( s[i % signals].connect( slot ) );
+			owner.push_back( i % signals );
+		}
+		std::mt19937 random{ 42 };
+		std::uniform_int_distribution<std::size_t> pick{ 0, count-1 };
+		for( std::size_t i = 0; i < count; ++i ) {
+			auto index = pick( random );
+			connections[index].disconnect();
+			connections[index] = s[ owner[index] ].connect( slot );
+		}
+		return m.finish( "churn", signals, count, empty_signal_bytes );
+	}
+
+	void print( std::ostream& out, result const& r ) {
+		out << r.name << ": " << r.signals << " signals, " << r.connections << " connections, "
+		    << r.heap_bytes << " heap bytes, " << r.rss_bytes << " RSS bytes, "
+		    << r.allocations << " allocations, "
+		    << r.bytes_per_signal << " bytes/signal, " << r.bytes_per_connection << " bytes/connection\n";
+	}
+
+	void write_json( std::ostream& out, std::vector<result> const& results ) {
+		char date[32];
+		std::time_t now = std::time( nullptr );
+		std::strftime( date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime( &now ) );
+		out.precision( 2 );
+		out << std::fixed;
+		out << "{\n";
+		out << "  \"context\": {\n";
+		out << "    \"library\": \"nod\",\n";
+		out << "    \"date\": \"" << date << "\",\n";
+		out << "    \"sizeof_signal\": " << sizeof( signal_type ) << ",\n";
+		out << "    \"sizeof_connection\": " << sizeof( nod::connection ) << ",\n";
+		out << "    \"sizeof_slot\": " << sizeof( signal_type::slot_type ) << ",\n";
+		out << "    \"unit\": \"bytes\"\n";
+		out << "  },\n";
+		out << "  \"shapes\": [";
+		for( std::size_t i = 0; i < results.size(); ++i ) {
+			auto const& r = results[i];
+			out << (i == 0 ? "\n" : ",\n");
+			out << "    {\n";
+			out << "      \"name\": \"" << r.name << "\",\n";
+			out << "      \"signals\": " << r.signals << ",\n";
+			out << "      \"connections\": " << r.connections << ",\n";
+			out << "      \"heap_bytes\": " << r.heap_bytes << ",\n";
+			out << "      \"rss_bytes\": " << r.rss_bytes << ",\n";
+			out << "      \"allocations\": " << r.allocations << ",\n";
+			out << "      \"bytes_per_signal\": " << r.bytes_per_signal << ",\n";
+			out << "      \"bytes_per_connection\": " << r.bytes_per_connection << "\n";
+			out << "    }";
+		}
+		out << "\n  ]\n";
+		out << "}\n";
+	}
+
+}	// anonymous namespace
+
+int main( int argc, char** argv ) {
+	options opts;
+	if( !parse( argc, argv, opts ) ) {
+		print_usage( argv[0] );
+		return 1;
+	}
+	std::vector<result> results;
+	results.push_back( empty_signals( opts.signals ) );
+	print( std::cerr, results.back() );
+	double const empty_signal_bytes = results.back().bytes_per_signal;
+	results.push_back( many_signals_one_slot( opts.signals, empty_signal_bytes ) );
+	print( std::cerr, results.back() );
+	results.push_back( few_signals_many_slots( 10, opts.connections, empty_signal_bytes ) );
+	print( std::cerr, results.back() );
+	results.push_back( churn( std::max<std::size_t>( opts.connections / 1000, 1 ), opts.connections, empty_signal_bytes ) );
+	print( std::cerr, results.back() );
+	if( opts.out.empty() ) {
+		write_json( std::cout, results );
+	}
+	else {
+		std::ofstream file{ opts.out };
+		write_json( file, results );
+		if( !file ) {
+			std::cerr << "Unable to write " << opts.out << "\n";
+			return 1;
+		}
+	}
+	return 0;
+}
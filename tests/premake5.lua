@@ -12,6 +12,8 @@ solution "nod_tests"
 	if _ACTION == "gmake" then
 		buildoptions     { "-Wall" }
 		buildoptions     { "-std=c++11" }
+		buildoptions     { "-pthread" }
+		linkoptions      { "-pthread" }
 	end
 
 	-- Since premake doesn't implement the clean command
@@ -46,3 +48,72 @@ project "nod_tests"
 		"**.hpp",
 		"**.cpp" 
 	}
+	excludes {
+		"allocation/**",
+		"cpp17/**",
+		"bench/**",
+		"memory/**",
+		"tools/**"
+	}
+
+-- The allocation test project definition. The tests replace the global
+-- allocation functions, so they are kept out of the other tests.
+project "nod_allocation_tests"
+	language    "C++"
+	kind        "ConsoleApp"
+	uuid        "5c2d8e6a-1f4b-4d97-b3a0-7e9f2c61d845"
+	files {
+		"allocation/**.cpp",
+		"main.cpp"
+	}
+
+-- The C++17 test project definition, for library features that need a
+-- newer standard, like polymorphic allocators.
+project "nod_cpp17_tests"
+	language    "C++"
+	kind        "ConsoleApp"
+	uuid        "2e7b9c41-5d3a-4f86-a1c0-96d4e8b3f7a2"
+	if _ACTION == "gmake" then
+		buildoptions { "-std=c++17" }
+	end
+	files {
+		"cpp17/**.cpp",
+		"main.cpp"
+	}
+
+-- The benchmark project definition
+project "nod_bench"
+	language    "C++"
+	kind        "ConsoleApp"
+	uuid        "3f0c5e2a-8d1b-4c7e-9a64-2b7f1d5e0c93"
+	files {
+		"bench/**.hpp",
+		"bench/**.cpp"
+	}
+
+-- The memory footprint benchmark project definition
+project "nod_memory_bench"
+	language    "C++"
+	kind        "ConsoleApp"
+	uuid        "6e1f9b3d-2a47-4c58-8d0e-f7b25c94a1e3"
+	files {
+		"memory/**.cpp"
+	}
+
+-- The flight recorder dump decoder
+project "nod_flight_decode"
+	language    "C++"
+	kind        "ConsoleApp"
+	uuid        "8b2e4f71-0c3d-4a95-b6e8-5d19c7a24f06"
+	files {
+		"tools/flight_decode.cpp"
+	}
+
+-- The benchmark result comparator
+project "nod_bench_compare"
+	language    "C++"
+	kind        "ConsoleApp"
+	uuid        "d4a7c1e9-6f2b-4e83-a05d-9c3e8b71f2a4"
+	files {
+		"tools/bench_compare.cpp"
+	}
@@ -0,0 +1,142 @@
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace {
+	/// Allocator counting the allocations made through it
+	template <class T>
+	struct counting_allocator {
+		using value_type = T;
+
+		explicit counting_allocator( std::size_t& count ) :
+			allocations( &count )
+		{}
+
+		template <class U>
+		counting_allocator( counting_allocator<U> const& other ) :
+			allocations( other.allocations )
+		{}
+
+		T* allocate( std::size_t n ) {
+			++*allocations;
+			return static_cast<T*>( ::operator new( n * sizeof(T) ) );
+		}
+
+		void deallocate( T* ptr, std::size_t ) {
+			::operator delete( ptr );
+		}
+
+		std::size_t* allocations;
+	};
+
+	template <class T, class U>
+	bool operator==( counting_allocator<T> const& a, counting_allocator<U> const& b ) {
+		return a.allocations == b.allocations;
+	}
+
+	template <class T, class U>
+	bool operator!=( counting_allocator<T> const& a, counting_allocator<U> const& b ) {
+		return !( a == b );
+	}
+
+	using counting_signal = nod::signal_type<nod::allocator_policy<counting_allocator<char>>, int(int)>;
+	using pool_signal = nod::signal_type<nod::slot_pool_policy<>, int(int)>;
+	using counting_homogeneous_signal = nod::homogeneous_signal_type<nod::allocator_policy<counting_allocator<char>>, int(*)(int), int(int)>;
+
+	int twice( int x ) {
+		return x * 2;
+	}
+}
+
+SCENARIO( "Signals allocate slot storage with the allocator of the thread policy" ) {
+	GIVEN( "a signal constructed with a counting allocator" ) {
+		std::size_t allocations = 0;
+		counting_signal signal{ counting_signal::allocator_type{ allocations } };
+		REQUIRE( signal.get_allocator().allocations == &allocations );
+		WHEN( "we connect a slot" ) {
+			signal.connect( []( int x ) { return x; } );
+			THEN( "the slot vector is allocated with the allocator" ) {
+				REQUIRE( allocations == 1 );
+			}
+			AND_WHEN( "we trigger the signal" ) {
+				signal( 1 );
+				auto values = signal.aggregate<std::vector<int>>( 2 );
+				auto results = signal.results( 3 );
+				THEN( "the snapshots and the range are allocated with the allocator" ) {
+					REQUIRE( values == (std::vector<int>{ 2 }) );
+					REQUIRE( *results.begin() == 3 );
+					// The slot vector, the copy of the slots of each of the
+					// three emissions, and the entries of the range.
+					REQUIRE( allocations == 5 );
+				}
+			}
+		}
+	}
+	GIVEN( "a named signal constructed with a counting allocator" ) {
+		std::size_t allocations = 0;
+		counting_signal signal{ "counted", counting_signal::allocator_type{ allocations } };
+		signal.connect( []( int x ) { return x * 2; } );
+		THEN( "it behaves like other signals" ) {
+			REQUIRE( signal.accumulate( 0, std::plus<int>{} )( 21 ) == 42 );
+			REQUIRE( allocations == 2 );
+		}
+	}
+	GIVEN( "a homogeneous signal constructed with a counting allocator" ) {
+		std::size_t allocations = 0;
+		counting_homogeneous_signal signal{ counting_homogeneous_signal::allocator_type{ allocations } };
+		REQUIRE( signal.get_allocator().allocations == &allocations );
+		signal.connect( &twice );
+		THEN( "the slot storage is allocated with the allocator" ) {
+			REQUIRE( allocations > 0 );
+		}
+		WHEN( "we trigger the signal" ) {
+			auto const connected = allocations;
+			signal( 1 );
+			auto sum = signal.accumulate( 0, std::plus<int>{} )( 21 );
+			THEN( "the emissions share the slot storage without allocating" ) {
+				REQUIRE( sum == 42 );
+				REQUIRE( allocations == connected );
+			}
+		}
+	}
+}
+
+SCENARIO( "The slot pool allocator reuses freed memory of the thread" ) {
+	GIVEN( "a freed block of the pool" ) {
+		nod::slot_pool_allocator<int> allocator;
+		int* first = allocator.allocate( 10 );
+		allocator.deallocate( first, 10 );
+		WHEN( "we allocate a block of a similar size" ) {
+			int* second = allocator.allocate( 12 );
+			THEN( "the freed block is reused" ) {
+				REQUIRE( second == first );
+			}
+			allocator.deallocate( second, 12 );
+		}
+	}
+	GIVEN( "a signal using the slot pool policy" ) {
+		pool_signal signal;
+		signal.connect( []( int x ) { return x + 1; } );
+		auto c = signal.connect( []( int x ) { return x * 2; } );
+		WHEN( "we trigger the signal repeatedly, also from other threads" ) {
+			int sum = 0;
+			for( int i = 0; i < 100; ++i ) {
+				sum += signal.accumulate( 0, std::plus<int>{} )( 1 );
+			}
+			std::thread other{ [&signal](){
+				for( int i = 0; i < 100; ++i ) {
+					signal( i );
+				}
+			} };
+			other.join();
+			c.disconnect();
+			THEN( "the signal behaves like other signals" ) {
+				REQUIRE( sum == 400 );
+				REQUIRE( signal.aggregate<std::vector<int>>( 1 ) == (std::vector<int>{ 2 }) );
+				REQUIRE( signal.slot_count() == 1 );
+			}
+		}
+	}
+}
@@ -3,7 +3,12 @@
 
 #include <catch.hpp>
 
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 SCENARIO( "Connection objects are default constructible" ) {
 	GIVEN( "a default constructed connection" ) {
@@ -199,3 +204,98 @@ SCENARIO( "Scoped connections can be released" ) {
 		}
 	}
 }
+
+SCENARIO( "Disconnected slots are kept alive by emissions in progress" ) {
+	GIVEN( "A signal with a slot that disconnects itself" ) {
+		nod::signal<void()> signal;
+		auto state = std::make_shared<int>( 0 );
+		std::weak_ptr<int> observer = state;
+		nod::connection connection;
+		connection = signal.connect( [state, &connection](){
+			connection.disconnect();
+			// The captured state is still alive after disconnecting.
+			++*state;
+		} );
+		state.reset();
+		WHEN( "the signal is triggered" ) {
+			signal();
+			THEN( "the slot finished its call, and was released afterwards" ) {
+				REQUIRE( connection.connected() == false );
+				REQUIRE( observer.expired() );
+			}
+		}
+	}
+	GIVEN( "A signal with a slot capturing shared state" ) {
+		nod::signal<void()> signal;
+		auto state = std::make_shared<int>( 0 );
+		signal.connect( [state](){ ++*state; } );
+		long const uses = state.use_count();
+		WHEN( "the signal is triggered" ) {
+			signal();
+			THEN( "the copies of the slot are released after the emission" ) {
+				REQUIRE( state.use_count() == uses );
+				REQUIRE( *state == 1 );
+			}
+		}
+	}
+}
+
+SCENARIO( "Emissions call copies of the slots, unless the slots are shared" ) {
+	GIVEN( "signals with a mutable slot counting its calls" ) {
+		nod::signal<void(std::vector<int>&)> signal;
+		nod::unsafe_signal<void(std::vector<int>&)> unsafe_signal;
+		nod::signal_type<nod::shared_slots_policy<>, void(std::vector<int>&)> shared_signal;
+		int count = 0;
+		auto counter = [count]( std::vector<int>& calls ) mutable { calls.push_back( ++count ); };
+		signal.connect( counter );
+		unsafe_signal.connect( counter );
+		shared_signal.connect( counter );
+		WHEN( "the signals are triggered three times" ) {
+			std::vector<int> calls;
+			std::vector<int> unsafe_calls;
+			std::vector<int> shared_calls;
+			for( int i = 0; i < 3; ++i ) {
+				signal( calls );
+				unsafe_signal( unsafe_calls );
+				shared_signal( shared_calls );
+			}
+			THEN( "each emission calls a fresh copy of the slot" ) {
+				REQUIRE( calls == (std::vector<int>{ 1, 1, 1 }) );
+				REQUIRE( unsafe_calls == (std::vector<int>{ 1, 1, 1 }) );
+			}
+			THEN( "the state of a shared slot is kept between emissions" ) {
+				REQUIRE( shared_calls == (std::vector<int>{ 1, 2, 3 }) );
+			}
+		}
+	}
+	GIVEN( "a signal with a slot recording the address it's called on" ) {
+		struct recorder {
+			std::mutex* mutex;
+			std::set<void const*>* addresses;
+			void operator()() const {
+				std::lock_guard<std::mutex> lock{ *mutex };
+				addresses->insert( this );
+			}
+		};
+		std::mutex mutex;
+		std::set<void const*> addresses;
+		nod::signal_type<nod::shared_slots_policy<>, void()> signal;
+		signal.connect( recorder{ &mutex, &addresses } );
+		WHEN( "the signal is triggered from several threads" ) {
+			std::vector<std::thread> threads;
+			for( int t = 0; t < 4; ++t ) {
+				threads.emplace_back( [&signal](){
+						for( int i = 0; i < 100; ++i ) {
+							signal();
+						}
+					} );
+			}
+			for( auto& thread : threads ) {
+				thread.join();
+			}
+			THEN( "all threads call the same slot object" ) {
+				REQUIRE( addresses.size() == 1 );
+			}
+		}
+	}
+}
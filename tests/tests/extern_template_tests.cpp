@@ -0,0 +1,60 @@
+#include <nod/nod_fwd.hpp>
+
+namespace {
+	// Functions taking signals only need the forward declarations.
+	void trigger( nod::signal<int(int, int)> const& signal, int& result );
+	void trigger( nod::unsafe_signal<void(int)> const& signal );
+}
+
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <string>
+
+NOD_EXTERN_SIGNAL( int(int, int) )
+NOD_EXTERN_UNSAFE_SIGNAL( void(int) )
+
+namespace {
+	void trigger( nod::signal<int(int, int)> const& signal, int& result ) {
+		result = signal.accumulate( 0, std::plus<int>{} )( 3, 4 );
+	}
+
+	void trigger( nod::unsafe_signal<void(int)> const& signal ) {
+		signal( 42 );
+	}
+}
+
+SCENARIO( "Explicitly instantiated signals can be used like other signals" ) {
+	GIVEN( "a signal declared with NOD_EXTERN_SIGNAL" ) {
+		nod::signal<int(int, int)> signal;
+		signal.connect( std::plus<int>{} );
+		signal.connect( std::multiplies<int>{} );
+		WHEN( "we trigger the signal through a forward declared function" ) {
+			int result = 0;
+			trigger( signal, result );
+			THEN( "the slots are called" ) {
+				REQUIRE( result == 19 );
+				REQUIRE( signal.slot_count() == 2 );
+			}
+		}
+	}
+	GIVEN( "a signal declared with NOD_EXTERN_UNSAFE_SIGNAL" ) {
+		nod::unsafe_signal<void(int)> signal;
+		int received = 0;
+		auto connection = signal.connect( [&received]( int x ) { received = x; } );
+		WHEN( "we trigger the signal and disconnect the slot" ) {
+			trigger( signal );
+			connection.disconnect();
+			trigger( signal );
+			THEN( "the slot is only called while connected" ) {
+				REQUIRE( received == 42 );
+				REQUIRE( signal.empty() );
+			}
+		}
+	}
+}
+
+// The explicit instantiations would normally live in a single source file.
+NOD_INSTANTIATE_SIGNAL( int(int, int) )
+NOD_INSTANTIATE_UNSAFE_SIGNAL( void(int) )
+NOD_INSTANTIATE_SIGNAL( void(std::string const&) )
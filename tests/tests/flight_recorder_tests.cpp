@@ -0,0 +1,154 @@
+#include <nod/instrument/flight_recorder.hpp>
+#include <catch.hpp>
+
+#include <cstdio>
+#include <map>
+#include <thread>
+
+namespace {
+	using recorded_signal = nod::signal_type<nod::flight_recorder_policy<>, void()>;
+
+	std::size_t const ring_capacity = nod::detail::flight_ring::capacity;
+	std::uint32_t const format_version = nod::flight_recorder::format_version;
+
+	/// A emission read back from a dump
+	struct emission {
+		std::uint32_t thread_id;
+		std::uint32_t signal_id;
+		std::uint32_t slot_count;
+		std::int64_t duration;
+	};
+
+	/// Contents of a dump
+	struct dump {
+		std::map<std::string, std::uint32_t> signal_ids;
+		std::vector<emission> emissions;
+		std::uint32_t thread_count;
+
+		std::size_t count( std::string const& name ) const {
+			std::size_t result = 0;
+			for( auto const& e : emissions ) {
+				result += e.signal_id == signal_ids.at( name ) ? 1 : 0;
+			}
+			return result;
+		}
+	};
+
+	template <class T>
+	T read( std::FILE* file ) {
+		T value{};
+		REQUIRE( std::fread( &value, sizeof(T), 1, file ) == 1 );
+		return value;
+	}
+
+	dump read_dump() {
+		std::FILE* file = std::tmpfile();
+		REQUIRE( file != nullptr );
+		REQUIRE( nod::flight_recorder::dump( file ) );
+		std::rewind( file );
+		char magic[8];
+		REQUIRE( std::fread( magic, 1, 8, file ) == 8 );
+		REQUIRE( std::string( magic, 8 ) == "NODFLREC" );
+		REQUIRE( read<std::uint32_t>( file ) == format_version );
+		read<std::int64_t>( file );
+		read<std::int64_t>( file );
+		dump result;
+		auto name_count = read<std::uint32_t>( file );
+		for( std::uint32_t i = 0; i < name_count; ++i ) {
+			auto id = read<std::uint32_t>( file );
+			std::string name( read<std::uint32_t>( file ), '\0' );
+			REQUIRE( std::fread( &name[0], 1, name.size(), file ) == name.size() );
+			result.signal_ids[name] = id;
+		}
+		result.thread_count = read<std::uint32_t>( file );
+		for( std::uint32_t t = 0; t < result.thread_count; ++t ) {
+			auto thread_id = read<std::uint32_t>( file );
+			auto count = read<std::uint32_t>( file );
+			for( std::uint32_t i = 0; i < count; ++i ) {
+				emission e;
+				e.thread_id = thread_id;
+				e.signal_id = read<std::uint32_t>( file );
+				e.slot_count = read<std::uint32_t>( file );
+				read<std::int64_t>( file );
+				e.duration = read<std::int64_t>( file );
+				result.emissions.push_back( e );
+			}
+		}
+		REQUIRE( std::fgetc( file ) == EOF );
+		std::fclose( file );
+		return result;
+	}
+}
+
+SCENARIO( "Signals with the flight recorder policy record their recent emissions" ) {
+	GIVEN( "a named signal with two slots" ) {
+		recorded_signal signal{ "flight_two_slots" };
+		signal.connect( [](){} );
+		signal.connect( [](){} );
+		WHEN( "we trigger the signal three times and dump the recorder" ) {
+			signal();
+			signal();
+			signal();
+			auto d = read_dump();
+			THEN( "the three emissions are in the dump, with their slot count" ) {
+				REQUIRE( d.count( "flight_two_slots" ) == 3 );
+				for( auto const& e : d.emissions ) {
+					if( e.signal_id == d.signal_ids.at( "flight_two_slots" ) ) {
+						REQUIRE( e.slot_count == 2 );
+						REQUIRE( e.duration >= 0 );
+					}
+				}
+			}
+		}
+	}
+	GIVEN( "a named signal triggered more times than a ring can hold" ) {
+		recorded_signal signal{ "flight_overflow" };
+		signal.connect( [](){} );
+		WHEN( "we trigger the signal from a new thread and dump the recorder" ) {
+			std::thread{ [&signal]() {
+					for( std::size_t i = 0; i < ring_capacity + 100; ++i ) {
+						signal();
+					}
+				}}.join();
+			auto d = read_dump();
+			THEN( "only the most recent emissions are kept" ) {
+				REQUIRE( d.count( "flight_overflow" ) == ring_capacity );
+			}
+		}
+	}
+}
+
+SCENARIO( "The flight recorder doesn't grow with short lived signals and threads" ) {
+	GIVEN( "a named signal that is destroyed" ) {
+		{
+			recorded_signal signal{ "flight_destroyed" };
+			signal.connect( [](){} );
+			signal();
+			REQUIRE( read_dump().signal_ids.count( "flight_destroyed" ) == 1 );
+		}
+		WHEN( "we dump the recorder" ) {
+			auto d = read_dump();
+			THEN( "the name of the signal has been forgotten" ) {
+				REQUIRE( d.signal_ids.count( "flight_destroyed" ) == 0 );
+			}
+		}
+	}
+	GIVEN( "a named signal" ) {
+		recorded_signal signal{ "flight_thread_churn" };
+		signal.connect( [](){} );
+		WHEN( "we trigger it from many threads, one after another" ) {
+			std::thread{ [&signal]() { signal(); } }.join();
+			auto before = read_dump().thread_count;
+			for( int i = 0; i < 16; ++i ) {
+				std::thread{ [&signal]() { signal(); } }.join();
+			}
+			auto d = read_dump();
+			THEN( "the threads take over the rings of the exited ones" ) {
+				REQUIRE( d.thread_count == before );
+			}
+			THEN( "the emission of the last thread is kept after it exited" ) {
+				REQUIRE( d.count( "flight_thread_churn" ) == 1 );
+			}
+		}
+	}
+}
@@ -0,0 +1,231 @@
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+	/// Slot recording its id into a shared vector
+	struct recording_slot {
+		std::vector<int>* calls;
+		int id;
+		int operator()( int x ) const {
+			calls->push_back( id );
+			return x * id;
+		}
+	};
+
+	/// Slot counting its calls in its own state
+	struct counting_slot {
+		int calls;
+		int operator()( int ) {
+			return ++calls;
+		}
+	};
+
+	/// Slot adding to a shared counter
+	struct adding_slot {
+		std::atomic<int>* total;
+		void operator()( int x ) const {
+			total->fetch_add( x );
+		}
+	};
+
+	/// Slot calling a function, used to modify the signal while it is
+	/// triggered.
+	struct callback_slot {
+		std::function<void()> callback;
+		void operator()() const {
+			callback();
+		}
+	};
+
+	using signal_type = nod::homogeneous_signal<recording_slot, int(int)>;
+}
+
+SCENARIO( "Homogeneous signals call slots of a single type" ) {
+	GIVEN( "a homogeneous signal with three connected slots" ) {
+		std::vector<int> calls;
+		signal_type signal;
+		auto c1 = signal.connect( recording_slot{ &calls, 1 } );
+		auto c2 = signal.connect( recording_slot{ &calls, 2 } );
+		auto c3 = signal.connect( recording_slot{ &calls, 3 } );
+		THEN( "the slots are counted" ) {
+			REQUIRE( signal.slot_count() == 3 );
+			REQUIRE_FALSE( signal.empty() );
+		}
+		WHEN( "we trigger the signal" ) {
+			signal( 5 );
+			THEN( "the slots are called in connection order" ) {
+				REQUIRE( calls == (std::vector<int>{ 1, 2, 3 }) );
+			}
+		}
+		WHEN( "we disconnect the middle slot and trigger the signal" ) {
+			c2.disconnect();
+			signal( 5 );
+			THEN( "only the connected slots are called" ) {
+				REQUIRE( calls == (std::vector<int>{ 1, 3 }) );
+				REQUIRE( signal.slot_count() == 2 );
+				REQUIRE_FALSE( c2.connected() );
+			}
+		}
+		WHEN( "we accumulate the slot return values" ) {
+			auto sum = signal.accumulate( 0, []( int a, int b ) { return a + b; } )( 2 );
+			THEN( "the sum of the return values is returned" ) {
+				REQUIRE( sum == 12 );
+			}
+		}
+		WHEN( "we aggregate the slot return values" ) {
+			auto values = signal.aggregate<std::vector<int>>( 2 );
+			THEN( "the return values are collected in order" ) {
+				REQUIRE( values == (std::vector<int>{ 2, 4, 6 }) );
+			}
+		}
+		WHEN( "we disconnect all slots" ) {
+			signal.disconnect_all_slots();
+			signal( 5 );
+			THEN( "no slots are called, and the connections are invalid" ) {
+				REQUIRE( calls.empty() );
+				REQUIRE( signal.empty() );
+				REQUIRE_FALSE( c1.connected() );
+				REQUIRE_FALSE( c3.connected() );
+			}
+		}
+	}
+	GIVEN( "a homogeneous signal outliving a scoped connection" ) {
+		std::vector<int> calls;
+		nod::unsafe_homogeneous_signal<recording_slot, int(int)> signal;
+		{
+			nod::scoped_connection connection = signal.connect( recording_slot{ &calls, 7 } );
+			signal( 1 );
+		}
+		WHEN( "we trigger the signal after the scope" ) {
+			signal( 1 );
+			THEN( "the slot was only called within the scope" ) {
+				REQUIRE( calls == (std::vector<int>{ 7 }) );
+				REQUIRE( signal.empty() );
+			}
+		}
+	}
+	GIVEN( "a connection outliving its homogeneous signal" ) {
+		std::vector<int> calls;
+		nod::connection connection;
+		{
+			signal_type signal;
+			connection = signal.connect( recording_slot{ &calls, 1 } );
+			REQUIRE( connection.connected() );
+		}
+		THEN( "the connection is no longer connected" ) {
+			REQUIRE_FALSE( connection.connected() );
+			connection.disconnect();
+		}
+	}
+}
+
+SCENARIO( "Homogeneous signals keep the state of their slots" ) {
+	GIVEN( "a homogeneous signal with a slot counting its calls" ) {
+		nod::homogeneous_signal<counting_slot, int(int)> signal;
+		signal.connect( counting_slot{ 0 } );
+		WHEN( "we trigger the signal repeatedly" ) {
+			signal( 0 );
+			signal( 0 );
+			auto calls = signal.aggregate<std::vector<int>>( 0 );
+			THEN( "the slot counted all calls" ) {
+				REQUIRE( calls == (std::vector<int>{ 3 }) );
+			}
+		}
+	}
+	GIVEN( "a unsafe homogeneous signal with a slot counting its calls" ) {
+		nod::unsafe_homogeneous_signal<counting_slot, int(int)> signal;
+		signal.connect( counting_slot{ 0 } );
+		WHEN( "we trigger the signal repeatedly" ) {
+			signal( 0 );
+			signal( 0 );
+			auto calls = signal.accumulate( 0, std::plus<int>{} )( 0 );
+			THEN( "the slot counted all calls" ) {
+				REQUIRE( calls == 3 );
+			}
+		}
+	}
+}
+
+template <class S>
+static void modify_while_triggered( std::vector<int> const& first_emission ) {
+	S signal;
+	std::vector<int> calls;
+	nod::connection first;
+	nod::connection last;
+	first = signal.connect( callback_slot{ [&](){
+		calls.push_back( 1 );
+		if( calls.size() == 1 ) {
+			// Connect a slot, and disconnect this slot and the last slot
+			// while they are called.
+			signal.connect( callback_slot{ [&](){ calls.push_back( 3 ); } } );
+			first.disconnect();
+			last.disconnect();
+		}
+	} } );
+	last = signal.connect( callback_slot{ [&](){ calls.push_back( 2 ); } } );
+	signal();
+	REQUIRE( calls == first_emission );
+	REQUIRE( signal.slot_count() == 1 );
+	calls.clear();
+	signal();
+	REQUIRE( calls == (std::vector<int>{ 3 }) );
+	signal.connect( callback_slot{ [&](){
+		calls.push_back( 4 );
+		signal.disconnect_all_slots();
+	} } );
+	signal();
+	REQUIRE( calls == (std::vector<int>{ 3, 3, 4 }) );
+	REQUIRE( signal.empty() );
+	signal();
+	REQUIRE( calls.size() == 3 );
+}
+
+SCENARIO( "Slots of homogeneous signals can modify the signal" ) {
+	GIVEN( "a homogeneous signal" ) {
+		THEN( "slots can connect and disconnect slots while they are called" ) {
+			// The emission calls the slots connected when it started.
+			modify_while_triggered<nod::homogeneous_signal<callback_slot, void()>>( { 1, 2 } );
+		}
+	}
+	GIVEN( "a unsafe homogeneous signal" ) {
+		THEN( "slots can connect and disconnect slots while they are called" ) {
+			// The emission no longer calls the disconnected slot.
+			modify_while_triggered<nod::unsafe_homogeneous_signal<callback_slot, void()>>( { 1 } );
+		}
+	}
+}
+
+SCENARIO( "Homogeneous signals can be used from several threads" ) {
+	GIVEN( "a homogeneous signal with a connected slot" ) {
+		std::atomic<int> total{ 0 };
+		nod::homogeneous_signal<adding_slot, void(int)> signal;
+		signal.connect( adding_slot{ &total } );
+		WHEN( "threads trigger the signal while slots are connected and disconnected" ) {
+			std::vector<std::thread> threads;
+			for( int t = 0; t < 2; ++t ) {
+				threads.emplace_back( [&signal](){
+					for( int i = 0; i < 1000; ++i ) {
+						signal( 1 );
+					}
+				} );
+			}
+			std::atomic<int> other{ 0 };
+			for( int i = 0; i < 200; ++i ) {
+				auto connection = signal.connect( adding_slot{ &other } );
+				connection.disconnect();
+			}
+			for( auto& thread : threads ) {
+				thread.join();
+			}
+			THEN( "the connected slot was called by every emission" ) {
+				REQUIRE( total == 2000 );
+				REQUIRE( signal.slot_count() == 1 );
+			}
+		}
+	}
+}
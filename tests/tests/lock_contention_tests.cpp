@@ -0,0 +1,113 @@
+#include <nod/instrument/lock_contention.hpp>
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace {
+	using contention_signal = nod::signal_type<nod::lock_contention_policy<>, void()>;
+
+	/// Mutex that can be told to stay locked for a while after it's
+	/// next acquired. Signals don't copy or destroy slots while holding
+	/// their mutex, so this simulates a slow operation under the lock.
+	struct slow_mutex {
+		static std::atomic<bool> hold_next;
+		static std::atomic<bool> holding;
+
+		void lock() {
+			_mutex.lock();
+			hold();
+		}
+
+		bool try_lock() {
+			if( _mutex.try_lock() ) {
+				hold();
+				return true;
+			}
+			return false;
+		}
+
+		void unlock() {
+			holding = false;
+			_mutex.unlock();
+		}
+
+		void hold() {
+			if( hold_next.exchange( false ) ) {
+				holding = true;
+				std::this_thread::sleep_for( std::chrono::milliseconds{ 20 } );
+			}
+		}
+
+		std::mutex _mutex;
+	};
+
+	std::atomic<bool> slow_mutex::hold_next{ false };
+	std::atomic<bool> slow_mutex::holding{ false };
+
+	struct slow_policy : nod::multithread_policy {
+		using mutex_type = slow_mutex;
+		using mutex_lock_type = std::lock_guard<slow_mutex>;
+	};
+
+	using slow_signal = nod::signal_type<nod::lock_contention_policy<slow_policy>, void()>;
+}
+
+SCENARIO( "Signals with the lock contention policy record lock statistics" ) {
+	GIVEN( "a new signal" ) {
+		contention_signal signal;
+		THEN( "no locking has been recorded" ) {
+			auto stats = signal.lock_stats();
+			for( auto const& op : stats.operations ) {
+				REQUIRE( op.acquisitions == 0 );
+				REQUIRE( op.contended == 0 );
+				REQUIRE( op.hold_time.count() == 0 );
+			}
+		}
+		WHEN( "we connect, trigger and disconnect" ) {
+			auto c1 = signal.connect( [](){} );
+			auto c2 = signal.connect( [](){} );
+			signal();
+			signal();
+			signal();
+			c1.disconnect();
+			signal.disconnect_all_slots();
+			THEN( "the acquisitions are counted by operation" ) {
+				auto stats = signal.lock_stats();
+				REQUIRE( stats[ nod::lock_operation::connect ].acquisitions == 2 );
+				REQUIRE( stats[ nod::lock_operation::emit ].acquisitions == 3 );
+				REQUIRE( stats[ nod::lock_operation::disconnect ].acquisitions == 1 );
+				REQUIRE( stats[ nod::lock_operation::disconnect_all ].acquisitions == 1 );
+			}
+			AND_THEN( "no acquisitions were contended" ) {
+				auto stats = signal.lock_stats();
+				for( auto const& op : stats.operations ) {
+					REQUIRE( op.contended == 0 );
+					REQUIRE( op.wait_time.count() == 0 );
+				}
+			}
+		}
+	}
+	GIVEN( "a signal held locked by a slow connect on another thread" ) {
+		slow_signal signal;
+		slow_mutex::hold_next = true;
+		std::thread connector{ [&](){ signal.connect( [](){} ); } };
+		while( !slow_mutex::holding ) {
+			std::this_thread::yield();
+		}
+		WHEN( "we trigger the signal meanwhile" ) {
+			signal();
+			connector.join();
+			THEN( "the emission is counted as contended, with its wait time" ) {
+				auto stats = signal.lock_stats();
+				REQUIRE( stats[ nod::lock_operation::emit ].contended == 1 );
+				REQUIRE( stats[ nod::lock_operation::emit ].wait_time > std::chrono::nanoseconds{ 0 } );
+				REQUIRE( stats[ nod::lock_operation::emit ].max_wait_time == stats[ nod::lock_operation::emit ].wait_time );
+				REQUIRE( stats[ nod::lock_operation::connect ].acquisitions == 1 );
+				REQUIRE( stats[ nod::lock_operation::connect ].hold_time > std::chrono::nanoseconds{ 0 } );
+			}
+		}
+	}
+}
@@ -0,0 +1,147 @@
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+	using persistent_signal = nod::signal_type<nod::persistent_slots_policy<>, void(std::vector<int>&)>;
+
+	/// Connect a slot appending its id to the vector passed to the signal
+	nod::connection connect_id( persistent_signal& signal, int id ) {
+		return signal.connect( [id]( std::vector<int>& calls ) { calls.push_back( id ); } );
+	}
+
+	/// @returns The ids of the slots called when triggering the signal
+	std::vector<int> trigger( persistent_signal const& signal ) {
+		std::vector<int> calls;
+		signal( calls );
+		return calls;
+	}
+}
+
+SCENARIO( "Signals with persistent slots call slots in connection order" ) {
+	GIVEN( "a signal with enough slots for a tree of three levels" ) {
+		persistent_signal signal;
+		std::vector<nod::connection> connections;
+		std::vector<int> expected;
+		int const count = 40000;
+		for( int i = 0; i < count; ++i ) {
+			connections.push_back( connect_id( signal, i ) );
+			expected.push_back( i );
+		}
+		THEN( "all slots are called in order" ) {
+			REQUIRE( signal.slot_count() == static_cast<std::size_t>( count ) );
+			REQUIRE( trigger( signal ) == expected );
+		}
+		WHEN( "we disconnect random slots and connect new ones" ) {
+			std::mt19937 random{ 42 };
+			for( int round = 0; round < 2000; ++round ) {
+				std::uniform_int_distribution<std::size_t> pick{ 0, connections.size()-1 };
+				auto const index = pick( random );
+				connections[index].disconnect();
+				int const id = count + round;
+				connections.push_back( connect_id( signal, id ) );
+				// The id of a slot is the index of its connection.
+				auto it = std::find( expected.begin(), expected.end(), static_cast<int>( index ) );
+				if( it != expected.end() ) {
+					expected.erase( it );
+				}
+				expected.push_back( id );
+			}
+			THEN( "the remaining slots are called in connection order" ) {
+				REQUIRE( trigger( signal ) == expected );
+				REQUIRE( signal.slot_count() == expected.size() );
+			}
+		}
+		WHEN( "we disconnect the slots from the last one" ) {
+			for( int i = count-1; i >= 0; --i ) {
+				connections[i].disconnect();
+				expected.pop_back();
+				if( i % 997 == 0 || i < 40 ) {
+					REQUIRE( trigger( signal ) == expected );
+				}
+			}
+			THEN( "the signal is empty, and can be connected to again" ) {
+				REQUIRE( signal.empty() );
+				connect_id( signal, 7 );
+				REQUIRE( trigger( signal ) == std::vector<int>{ 7 } );
+			}
+		}
+	}
+	GIVEN( "a range of slot results taken before modifying the signal" ) {
+		nod::signal_type<nod::persistent_slots_policy<>, int()> signal;
+		std::vector<nod::connection> connections;
+		for( int i = 0; i < 100; ++i ) {
+			connections.push_back( signal.connect( [i](){ return i; } ) );
+		}
+		auto results = signal.results();
+		WHEN( "we modify the signal" ) {
+			connections[10].disconnect();
+			connections[99].disconnect();
+			signal.connect( [](){ return 1000; } );
+			THEN( "the range still calls the slots of its version" ) {
+				std::vector<int> values( results.begin(), results.end() );
+				REQUIRE( values.size() == 100 );
+				REQUIRE( values[10] == 10 );
+				REQUIRE( values[99] == 99 );
+				REQUIRE( signal.aggregate<std::vector<int>>().size() == 99 );
+			}
+		}
+	}
+	GIVEN( "a signal with a slot disconnecting itself" ) {
+		persistent_signal signal;
+		nod::connection self;
+		connect_id( signal, 1 );
+		self = signal.connect( [&self]( std::vector<int>& calls ) { self.disconnect(); calls.push_back( 2 ); } );
+		connect_id( signal, 3 );
+		WHEN( "we trigger the signal twice" ) {
+			auto first = trigger( signal );
+			auto second = trigger( signal );
+			THEN( "the slot is only called the first time" ) {
+				REQUIRE( first == (std::vector<int>{ 1, 2, 3 }) );
+				REQUIRE( second == (std::vector<int>{ 1, 3 }) );
+			}
+		}
+	}
+}
+
+SCENARIO( "Signals with persistent slots can be modified while triggered on other threads" ) {
+	GIVEN( "a signal triggered continuously by two threads" ) {
+		nod::signal_type<nod::persistent_slots_policy<>, void(int)> signal;
+		std::atomic<long> sum{ 0 };
+		std::atomic<bool> done{ false };
+		auto emit = [&](){
+			while( !done ) {
+				signal( 1 );
+			}
+		};
+		std::thread first{ emit };
+		std::thread second{ emit };
+		WHEN( "we connect and disconnect slots meanwhile" ) {
+			std::vector<nod::connection> connections;
+			for( int i = 0; i < 2000; ++i ) {
+				connections.push_back( signal.connect( [&sum]( int x ) { sum += x; } ) );
+				if( i % 3 == 0 ) {
+					connections[i / 2].disconnect();
+				}
+			}
+			done = true;
+			first.join();
+			second.join();
+			THEN( "the signal is left with the connected slots" ) {
+				std::size_t connected = 0;
+				for( auto const& c : connections ) {
+					connected += c.connected() ? 1 : 0;
+				}
+				REQUIRE( signal.slot_count() == connected );
+				sum = 0;
+				signal( 1 );
+				REQUIRE( sum == static_cast<long>( connected ) );
+			}
+		}
+	}
+}
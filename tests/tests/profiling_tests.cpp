@@ -0,0 +1,87 @@
+#include <nod/instrument/profiling.hpp>
+#include <catch.hpp>
+
+#include <chrono>
+#include <thread>
+
+namespace {
+	using profiled_signal = nod::signal_type<nod::profiling_policy<nod::multithread_policy, 4>, void()>;
+
+	void slow_slot() {
+		std::this_thread::sleep_for( std::chrono::milliseconds{ 2 } );
+	}
+
+	void fast_slot() {
+	}
+}
+
+SCENARIO( "Signals with the profiling policy record sampled slot timings" ) {
+	GIVEN( "a signal with a slow and a fast slot, sampling one out of four emissions" ) {
+		profiled_signal signal;
+		auto fast = signal.connect( fast_slot );
+		auto slow = signal.connect( slow_slot );
+		signal.label_slot( fast, "fast" );
+		signal.label_slot( slow, "slow" );
+		WHEN( "we trigger the signal eight times" ) {
+			for( int i = 0; i < 8; ++i ) {
+				signal();
+			}
+			auto profile = signal.profile();
+			THEN( "two emissions are sampled for each slot" ) {
+				REQUIRE( profile.sample_rate == 4 );
+				REQUIRE( profile.slots.size() == 2 );
+				REQUIRE( profile.slots[0].samples == 2 );
+				REQUIRE( profile.slots[1].samples == 2 );
+			}
+			AND_THEN( "the slots are labeled" ) {
+				REQUIRE( profile.slots[0].label == "fast" );
+				REQUIRE( profile.slots[1].label == "slow" );
+			}
+			AND_THEN( "the slow slot is identified" ) {
+				REQUIRE( profile.slots[1].mean() >= std::chrono::milliseconds{ 2 } );
+				REQUIRE( profile.slots[1].percentile( 99.0 ) >= std::chrono::milliseconds{ 2 } );
+				REQUIRE( profile.slots[1].max_time > profile.slots[0].max_time );
+			}
+			AND_THEN( "the timings of a slot can be retrieved through its connection" ) {
+				auto slow_profile = signal.profile( slow );
+				REQUIRE( slow_profile.label == "slow" );
+				REQUIRE( slow_profile.samples == 2 );
+			}
+		}
+		WHEN( "we disconnect the slow slot and connect a new slot in its place" ) {
+			signal();
+			slow.disconnect();
+			auto replacement = signal.connect( fast_slot );
+			THEN( "the new slot starts with an empty profile" ) {
+				auto replacement_profile = signal.profile( replacement );
+				REQUIRE( replacement_profile.samples == 0 );
+				REQUIRE( replacement_profile.label.empty() );
+			}
+			AND_THEN( "the disconnected slot has no profile through its connection" ) {
+				REQUIRE( signal.profile( slow ).samples == 0 );
+			}
+		}
+	}
+}
+
+SCENARIO( "Signals with the profiling policy are sampled independently of each other" ) {
+	GIVEN( "two signals sampling one out of two emissions" ) {
+		using signal_type = nod::signal_type<nod::profiling_policy<nod::multithread_policy, 2>, void()>;
+		signal_type first;
+		signal_type second;
+		first.connect( fast_slot );
+		second.connect( fast_slot );
+		WHEN( "we trigger the signals alternately on the same thread" ) {
+			for( int i = 0; i < 8; ++i ) {
+				first();
+				second();
+			}
+			THEN( "both signals have half of their emissions sampled" ) {
+				REQUIRE( first.profile().slots.size() == 1 );
+				REQUIRE( first.profile().slots[0].samples == 4 );
+				REQUIRE( second.profile().slots.size() == 1 );
+				REQUIRE( second.profile().slots[0].samples == 4 );
+			}
+		}
+	}
+}
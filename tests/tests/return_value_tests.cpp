@@ -1,7 +1,15 @@
 #include "../test_helpers.hpp"
 #include <nod/nod.hpp>
+#include <nod/parallel.hpp>
 #include <catch.hpp>
 #include <numeric>
+#include <string>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 SCENARIO( "It's possible to accumulate the return values of slots" ) {
 	GIVEN( "a signal with three slots that return a double" ) {
@@ -41,4 +49,365 @@ SCENARIO( "It's possible to aggregate the return values of slots into a containe
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+SCENARIO( "It's possible to accumulate the return values of slots in parallel" ) {
+	GIVEN( "a signal with many slots that return an int" ) {
+		nod::signal<int(int)> signal;
+		for( int i = 1; i <= 100; ++i ) {
+			signal.connect( [i]( int x ) { return i*x; } );
+		}
+		WHEN( "we accumulate the return values in parallel with std::plus<int>" ) {
+			auto result = signal.accumulate_parallel( 0, std::plus<int>{}, 4, 1 )( 2 );
+			THEN( "the result is the sum of all the slots return value" ) {
+				REQUIRE( result == 2*5050 );
+			}
+		}
+		AND_WHEN( "we accumulate using a associative but non-commutative operation" ) {
+			nod::signal<std::string()> letters;
+			std::string expected = "<";
+			for( char c = 'a'; c <= 'z'; ++c ) {
+				letters.connect( [c]() { return std::string( 1, c ); } );
+				expected += c;
+			}
+			auto result = letters.accumulate_parallel( std::string{"<"}, []( std::string const& a, std::string const& b ) {
+					return a + b;
+				}, 3, 1 )();
+			THEN( "the operand order is preserved" ) {
+				REQUIRE( result == expected );
+			}
+		}
+		AND_WHEN( "we use more workers than there are slots" ) {
+			nod::signal<int(int)> small;
+			small.connect( []( int x ) { return x; } );
+			small.connect( []( int x ) { return 2*x; } );
+			auto result = small.accumulate_parallel( 1, std::plus<int>{}, 16, 1 )( 3 );
+			THEN( "the result is still the sum of the slots return values and the initial value" ) {
+				REQUIRE( result == 10 );
+			}
+		}
+	}
+	GIVEN( "a signal without slots" ) {
+		nod::signal<int()> signal;
+		WHEN( "we accumulate the return values in parallel" ) {
+			auto result = signal.accumulate_parallel( 42, std::plus<int>{} )();
+			THEN( "the result is the initial value" ) {
+				REQUIRE( result == 42 );
+			}
+		}
+	}
+	GIVEN( "a signal with slots returning a type that is neither default constructible nor assignable" ) {
+		struct total {
+			explicit total( int v ) : value( v ) {}
+			total( total const& ) = default;
+			total( total&& ) = default;
+			total& operator=( total const& ) = delete;
+			int value;
+		};
+		nod::signal<total(int)> signal;
+		for( int i = 1; i <= 100; ++i ) {
+			signal.connect( [i]( int x ) { return total{ i*x }; } );
+		}
+		WHEN( "we accumulate the return values in parallel" ) {
+			auto add = []( total const& a, total const& b ) { return total{ a.value + b.value }; };
+			auto result = signal.accumulate_parallel( total{ 1 }, add, 4, 1 )( 2 );
+			THEN( "the result is the sum of the initial value and all the slots return value" ) {
+				REQUIRE( result.value == 1 + 2*5050 );
+			}
+		}
+	}
+	GIVEN( "a signal with fewer slots than the minimum for a second worker" ) {
+		nod::signal<int(std::thread::id)> signal;
+		for( int i = 0; i < 10; ++i ) {
+			signal.connect( []( std::thread::id caller ) { return caller == std::this_thread::get_id() ? 1 : 0; } );
+		}
+		WHEN( "we accumulate the return values in parallel" ) {
+			auto result = signal.accumulate_parallel( 0, std::plus<int>{}, 4, 6 )( std::this_thread::get_id() );
+			THEN( "all slots are called on the triggering thread" ) {
+				REQUIRE( result == 10 );
+			}
+		}
+	}
+}
+
+SCENARIO( "Worker pools call all chunks of a job" ) {
+	GIVEN( "a pool with three threads" ) {
+		nod::detail::worker_pool pool{ 3 };
+		REQUIRE( pool.size() == 3 );
+		WHEN( "we run a job with more chunks than threads, many times" ) {
+			std::atomic<int> calls{ 0 };
+			std::vector<int> chunks( 16 );
+			for( int round = 0; round < 200; ++round ) {
+				auto func = [&]( std::size_t chunk ) {
+					++chunks[chunk];
+					++calls;
+				};
+				pool.run( chunks.size(), func );
+			}
+			THEN( "each chunk is called once per job" ) {
+				REQUIRE( calls == 16 * 200 );
+				REQUIRE( std::all_of( chunks.begin(), chunks.end(), []( int n ) { return n == 200; } ) );
+			}
+		}
+		WHEN( "a chunk runs a job of its own" ) {
+			std::atomic<int> calls{ 0 };
+			auto inner = [&]( std::size_t ) { ++calls; };
+			auto outer = [&]( std::size_t ) { pool.run( 4, inner ); };
+			pool.run( 8, outer );
+			THEN( "all chunks of the nested jobs are called" ) {
+				REQUIRE( calls == 32 );
+			}
+		}
+		WHEN( "a chunk throws" ) {
+			std::atomic<int> calls{ 0 };
+			auto func = [&]( std::size_t chunk ) {
+				++calls;
+				if( chunk == 2 ) {
+					throw std::runtime_error( "chunk failed" );
+				}
+			};
+			THEN( "the exception is rethrown once all chunks have been called" ) {
+				REQUIRE_THROWS_AS( pool.run( 6, func ), std::runtime_error const& );
+				REQUIRE( calls == 6 );
+			}
+		}
+	}
+	GIVEN( "a pool without threads" ) {
+		nod::detail::worker_pool pool{ 0 };
+		WHEN( "we run a job" ) {
+			std::vector<int> chunks( 4 );
+			auto func = [&]( std::size_t chunk ) { ++chunks[chunk]; };
+			pool.run( chunks.size(), func );
+			THEN( "the calling thread calls all chunks" ) {
+				REQUIRE( chunks == (std::vector<int>{ 1, 1, 1, 1 }) );
+			}
+		}
+	}
+}
+
+SCENARIO( "It's possible to stop calling slots when a slot return value satisfies a predicate" ) {
+	GIVEN( "a signal with three slots that return an int, and count their calls" ) {
+		nod::signal<int(int)> signal;
+		std::vector<int> calls;
+		signal.connect( [&calls]( int x ) { calls.push_back(1); return x; } );
+		signal.connect( [&calls]( int x ) { calls.push_back(2); return 2*x; } );
+		signal.connect( [&calls]( int x ) { calls.push_back(3); return 3*x; } );
+		WHEN( "we trigger the signal until a slot returns a value greater than 15" ) {
+			auto result = signal.emit_until( []( int value ) { return value > 15; }, -1 )( 10 );
+			THEN( "the first satisfying value is returned" ) {
+				REQUIRE( result == 20 );
+			}
+			AND_THEN( "the slots after the satisfying slot are not called" ) {
+				REQUIRE( calls == (std::vector<int>{1,2}) );
+			}
+		}
+		WHEN( "we trigger the signal with a predicate that is never satisfied" ) {
+			auto result = signal.emit_until( []( int value ) { return value > 100; }, -1 )( 10 );
+			THEN( "the fallback value is returned" ) {
+				REQUIRE( result == -1 );
+			}
+			AND_THEN( "all slots are called" ) {
+				REQUIRE( calls == (std::vector<int>{1,2,3}) );
+			}
+		}
+		WHEN( "we trigger the signal without giving a fallback value" ) {
+			auto result = signal.emit_until( []( int value ) { return value < 0; } )( 10 );
+			THEN( "a value initialized result is returned" ) {
+				REQUIRE( result == 0 );
+			}
+		}
+	}
+}
+
+namespace {
+	// Value type that counts how many times instances are copied
+	struct copy_counter {
+		copy_counter() = default;
+		copy_counter( copy_counter const& other ) :
+			values( other.values ) {
+			++copies;
+		}
+		copy_counter( copy_counter&& other ) :
+			values( std::move(other.values) )
+		{}
+		copy_counter& operator=( copy_counter const& other ) {
+			values = other.values;
+			++copies;
+			return *this;
+		}
+		copy_counter& operator=( copy_counter&& other ) {
+			values = std::move(other.values);
+			return *this;
+		}
+		std::vector<double> values;
+		static int copies;
+	};
+	int copy_counter::copies = 0;
+}
+
+SCENARIO( "It's possible to accumulate the return values of slots without copying the accumulated value" ) {
+	GIVEN( "a signal with three slots that return a double" ) {
+		nod::signal<double(double,double)> signal;
+		signal.connect( std::multiplies<double>{} );
+		signal.connect( std::plus<double>{} );
+		signal.connect( std::minus<double>{} );
+		auto const expected = std::vector<double>{std::multiplies<double>{}(42,12), std::plus<double>{}(42,12), std::minus<double>{}(42,12)};
+		WHEN( "we accumulate in place into a container" ) {
+			auto accumulator = signal.accumulate_in_place( copy_counter{}, []( copy_counter& partial, double slot_result ) {
+					partial.values.push_back( slot_result );
+				});
+			copy_counter::copies = 0;
+			auto result = accumulator(42.0,12.0);
+			THEN( "the result contains all the return values of the slots" ) {
+				REQUIRE( result.values == expected );
+			}
+			AND_THEN( "the accumulated value is only copied from the initial value" ) {
+				REQUIRE( copy_counter::copies == 1 );
+			}
+		}
+		WHEN( "we accumulate with a function taking the accumulated value by value" ) {
+			auto accumulator = signal.accumulate( copy_counter{}, []( copy_counter partial, double slot_result ) {
+					partial.values.push_back( slot_result );
+					return partial;
+				});
+			copy_counter::copies = 0;
+			auto result = accumulator(42.0,12.0);
+			THEN( "the result contains all the return values of the slots" ) {
+				REQUIRE( result.values == expected );
+			}
+			AND_THEN( "the accumulated value is moved through the accumulation" ) {
+				REQUIRE( copy_counter::copies == 1 );
+			}
+		}
+	}
+	GIVEN( "a signal with many slots" ) {
+		nod::signal<double(double)> signal;
+		for( int i = 0; i < 1000; ++i ) {
+			signal.connect( [i]( double x ) { return x * i; } );
+		}
+		WHEN( "we build a vector with a function taking the accumulated value by value" ) {
+			auto accumulator = signal.accumulate( copy_counter{}, []( copy_counter partial, double slot_result ) {
+					partial.values.push_back( slot_result );
+					return partial;
+				});
+			copy_counter::copies = 0;
+			auto result = accumulator( 1.0 );
+			THEN( "the accumulated value is not copied for each slot" ) {
+				REQUIRE( result.values.size() == 1000 );
+				REQUIRE( result.values[999] == 999.0 );
+				REQUIRE( copy_counter::copies == 1 );
+			}
+		}
+		WHEN( "we build a vector in place" ) {
+			auto accumulator = signal.accumulate_in_place( copy_counter{}, []( copy_counter& partial, double slot_result ) {
+					partial.values.push_back( slot_result );
+				});
+			copy_counter::copies = 0;
+			auto result = accumulator( 1.0 );
+			THEN( "the accumulated value is only copied from the initial value" ) {
+				REQUIRE( result.values.size() == 1000 );
+				REQUIRE( copy_counter::copies == 1 );
+			}
+		}
+	}
+}
+
+SCENARIO( "It's possible to aggregate the return values of slots into existing containers and iterators" ) {
+	GIVEN( "a signal with three slots that return a double" ) {
+		nod::signal<double(double,double)> signal;
+		signal.connect( std::multiplies<double>{} );
+		signal.connect( std::plus<double>{} );
+		signal.connect( std::minus<double>{} );
+		auto const expected = std::vector<double>{std::multiplies<double>{}(42,12), std::plus<double>{}(42,12), std::minus<double>{}(42,12)};
+		WHEN( "we aggregate into a vector that already contains values" ) {
+			std::vector<double> result{ 1.0, 2.0, 3.0, 4.0, 5.0 };
+			auto count = signal.aggregate_into( result, 42.0, 12.0 );
+			THEN( "the vector only contains the slot return values" ) {
+				REQUIRE( count == 3 );
+				REQUIRE( result == expected );
+			}
+		}
+		WHEN( "we aggregate into the same vector twice" ) {
+			std::vector<double> result;
+			signal.aggregate_into( result, 1.0, 1.0 );
+			auto const data = result.data();
+			signal.aggregate_into( result, 42.0, 12.0 );
+			THEN( "the storage of the vector is reused" ) {
+				REQUIRE( result == expected );
+				REQUIRE( result.data() == data );
+			}
+		}
+		WHEN( "we aggregate through an output iterator" ) {
+			std::vector<double> result;
+			signal.aggregate_into( std::back_inserter(result), 42.0, 12.0 );
+			THEN( "all slot return values are written to the iterator" ) {
+				REQUIRE( result == expected );
+			}
+		}
+		WHEN( "we aggregate into a std::array with room for two values" ) {
+			std::array<double,2> result{{ 0.0, 0.0 }};
+			auto count = signal.aggregate_into( result, 42.0, 12.0 );
+			THEN( "the array contains the return values of the first two slots" ) {
+				REQUIRE( count == 2 );
+				REQUIRE( result[0] == expected[0] );
+				REQUIRE( result[1] == expected[1] );
+			}
+		}
+		WHEN( "we aggregate into a range larger than the number of slots" ) {
+			double result[5] = {};
+			auto last = signal.aggregate_into( std::begin(result), std::end(result), 42.0, 12.0 );
+			THEN( "the returned iterator is one past the last written value" ) {
+				REQUIRE( last == result+3 );
+				REQUIRE( (std::vector<double>{ result, last }) == expected );
+			}
+		}
+	}
+}
+
+SCENARIO( "It's possible to iterate lazily over the return values of slots" ) {
+	GIVEN( "a signal with slots that return an int, and count their calls" ) {
+		nod::signal<int(int)> signal;
+		int calls = 0;
+		signal.connect( [&calls]( int x ) { ++calls; return x; } );
+		auto disconnected = signal.connect( [&calls]( int x ) { ++calls; return -x; } );
+		signal.connect( [&calls]( int x ) { ++calls; return 3*x; } );
+		signal.connect( [&calls]( int x ) { ++calls; return 2*x; } );
+		disconnected.disconnect();
+		WHEN( "we create a range of results" ) {
+			auto results = signal.results( 10 );
+			THEN( "no slots are called" ) {
+				REQUIRE( calls == 0 );
+				REQUIRE( results.size() == 3 );
+			}
+		}
+		WHEN( "we search the range for the first value greater than 20" ) {
+			auto results = signal.results( 10 );
+			auto it = std::find_if( results.begin(), results.end(), []( int value ) { return value > 20; } );
+			THEN( "the value is found" ) {
+				REQUIRE( it != results.end() );
+				REQUIRE( *it == 30 );
+			}
+			AND_THEN( "only the slots up to the found value are called" ) {
+				REQUIRE( calls == 2 );
+			}
+		}
+		WHEN( "we find the largest value in the range" ) {
+			auto results = signal.results( 10 );
+			auto it = std::max_element( results.begin(), results.end() );
+			THEN( "the largest value is found" ) {
+				REQUIRE( *it == 30 );
+			}
+			AND_THEN( "each slot is only called once" ) {
+				REQUIRE( calls == 3 );
+			}
+		}
+		WHEN( "we accumulate and aggregate the range with standard algorithms" ) {
+			auto results = signal.results( 10 );
+			auto sum = std::accumulate( results.begin(), results.end(), 0 );
+			std::vector<int> values{ results.begin(), results.end() };
+			THEN( "the result is the same as for accumulate and aggregate" ) {
+				REQUIRE( sum == signal.accumulate( 0, std::plus<int>{} )( 10 ) );
+				REQUIRE( values == signal.aggregate<std::vector<int>>( 10 ) );
+			}
+		}
+	}
+}
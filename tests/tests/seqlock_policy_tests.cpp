@@ -0,0 +1,222 @@
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+	using seqlock_signal = nod::signal_type<nod::seqlock_policy<>, void(std::vector<int>&)>;
+
+	/// Connect a slot appending its id to the vector passed to the signal
+	nod::connection connect_id( seqlock_signal& signal, int id ) {
+		return signal.connect( [id]( std::vector<int>& calls ) { calls.push_back( id ); } );
+	}
+
+	/// @returns The ids of the slots called when triggering the signal
+	std::vector<int> trigger( seqlock_signal const& signal ) {
+		std::vector<int> calls;
+		signal( calls );
+		return calls;
+	}
+
+	/// Slot counting the instances of itself that are alive
+	struct counted_slot {
+		explicit counted_slot( std::atomic<int>& alive ) :
+			_alive( &alive )
+		{
+			++*_alive;
+		}
+		counted_slot( counted_slot const& other ) :
+			_alive( other._alive )
+		{
+			++*_alive;
+		}
+		~counted_slot() {
+			--*_alive;
+		}
+		void operator()( std::vector<int>& calls ) const {
+			calls.push_back( 0 );
+		}
+		std::atomic<int>* _alive;
+	};
+}
+
+SCENARIO( "Signals with a seqlock policy call their slots like other signals" ) {
+	GIVEN( "a signal with a few slots" ) {
+		seqlock_signal signal;
+		std::vector<nod::connection> connections;
+		for( int i = 0; i < 20; ++i ) {
+			connections.push_back( connect_id( signal, i ) );
+		}
+		THEN( "the slots are called in connection order" ) {
+			std::vector<int> expected;
+			for( int i = 0; i < 20; ++i ) {
+				expected.push_back( i );
+			}
+			REQUIRE( trigger( signal ) == expected );
+			REQUIRE( signal.slot_count() == 20 );
+		}
+		WHEN( "we disconnect some slots" ) {
+			connections[0].disconnect();
+			connections[7].disconnect();
+			connections[19].disconnect();
+			THEN( "only the connected slots are called" ) {
+				auto calls = trigger( signal );
+				REQUIRE( calls.size() == 17 );
+				REQUIRE( calls.front() == 1 );
+				REQUIRE( calls.back() == 18 );
+				REQUIRE( signal.slot_count() == 17 );
+			}
+		}
+		WHEN( "we disconnect all slots" ) {
+			signal.disconnect_all_slots();
+			THEN( "no slot is called, and new slots can be connected" ) {
+				REQUIRE( trigger( signal ).empty() );
+				REQUIRE( signal.empty() );
+				connect_id( signal, 42 );
+				REQUIRE( trigger( signal ) == std::vector<int>{ 42 } );
+			}
+		}
+	}
+	GIVEN( "a signal with a slot disconnecting itself" ) {
+		seqlock_signal signal;
+		nod::connection self;
+		connect_id( signal, 1 );
+		self = signal.connect( [&self]( std::vector<int>& calls ) { self.disconnect(); calls.push_back( 2 ); } );
+		connect_id( signal, 3 );
+		WHEN( "we trigger the signal twice" ) {
+			auto first = trigger( signal );
+			auto second = trigger( signal );
+			THEN( "the slot is only called the first time" ) {
+				REQUIRE( first == (std::vector<int>{ 1, 2, 3 }) );
+				REQUIRE( second == (std::vector<int>{ 1, 3 }) );
+			}
+		}
+	}
+	GIVEN( "a signal with a slot triggering the signal again" ) {
+		nod::signal_type<nod::seqlock_policy<>, void(int, std::vector<int>&)> signal;
+		signal.connect( [&signal]( int depth, std::vector<int>& calls ) {
+			calls.push_back( depth );
+			if( depth < 3 ) {
+				signal( depth + 1, calls );
+			}
+		} );
+		WHEN( "we trigger the signal" ) {
+			std::vector<int> calls;
+			signal( 0, calls );
+			THEN( "the nested emissions call the slot" ) {
+				REQUIRE( calls == (std::vector<int>{ 0, 1, 2, 3 }) );
+			}
+		}
+	}
+	GIVEN( "a range of slot results taken before disconnecting a slot" ) {
+		nod::signal_type<nod::seqlock_policy<>, int()> signal;
+		auto first = signal.connect( [](){ return 1; } );
+		signal.connect( [](){ return 2; } );
+		auto results = signal.results();
+		WHEN( "we disconnect the slot" ) {
+			first.disconnect();
+			THEN( "the range still calls it" ) {
+				std::vector<int> values( results.begin(), results.end() );
+				REQUIRE( values == (std::vector<int>{ 1, 2 }) );
+				REQUIRE( signal.aggregate<std::vector<int>>() == std::vector<int>{ 2 } );
+			}
+		}
+	}
+	GIVEN( "a signal with disconnected slots" ) {
+		std::atomic<int> alive{ 0 };
+		{
+			seqlock_signal signal;
+			std::vector<nod::connection> connections;
+			for( int i = 0; i < 10; ++i ) {
+				connections.push_back( signal.connect( counted_slot{ alive } ) );
+			}
+			for( auto& connection : connections ) {
+				connection.disconnect();
+			}
+			connect_id( signal, 1 );
+			REQUIRE( trigger( signal ) == std::vector<int>{ 1 } );
+		}
+		THEN( "the slots are destroyed with the signal at the latest" ) {
+			REQUIRE( alive == 0 );
+		}
+	}
+	GIVEN( "a slot disconnected while a emission on another thread is calling slots" ) {
+		std::atomic<int> alive{ 0 };
+		std::atomic<bool> entered{ false };
+		std::atomic<bool> finish{ false };
+		seqlock_signal signal;
+		signal.connect( [&]( std::vector<int>& ) {
+			entered = true;
+			while( !finish ) {
+				std::this_thread::yield();
+			}
+		} );
+		auto counted = signal.connect( counted_slot{ alive } );
+		std::thread emitter{ [&](){ trigger( signal ); } };
+		while( !entered ) {
+			std::this_thread::yield();
+		}
+		counted.disconnect();
+		THEN( "the slot is kept alive while the emission is in progress" ) {
+			REQUIRE( alive == 1 );
+		}
+		WHEN( "the emission finishes" ) {
+			finish = true;
+			emitter.join();
+			THEN( "the slot is destroyed without another modification of the signal" ) {
+				REQUIRE( alive == 0 );
+			}
+		}
+		finish = true;
+		if( emitter.joinable() ) {
+			emitter.join();
+		}
+	}
+}
+
+SCENARIO( "Signals with a seqlock policy can be modified while triggered on other threads" ) {
+	GIVEN( "a signal triggered continuously by several threads" ) {
+		nod::signal_type<nod::seqlock_policy<>, void(int)> signal;
+		std::atomic<long> sum{ 0 };
+		std::atomic<bool> done{ false };
+		auto emit = [&](){
+			while( !done ) {
+				signal( 1 );
+			}
+		};
+		std::vector<std::thread> threads;
+		for( int i = 0; i < 3; ++i ) {
+			threads.emplace_back( emit );
+		}
+		WHEN( "we connect and disconnect slots owning memory meanwhile" ) {
+			std::vector<nod::connection> connections;
+			for( int i = 0; i < 2000; ++i ) {
+				auto value = std::make_shared<int>( 1 );
+				connections.push_back( signal.connect( [&sum, value]( int x ) { sum += x * *value; } ) );
+				if( i % 3 == 0 ) {
+					connections[i / 2].disconnect();
+				}
+				if( i % 500 == 0 ) {
+					signal.disconnect_all_slots();
+				}
+			}
+			done = true;
+			for( auto& thread : threads ) {
+				thread.join();
+			}
+			THEN( "the signal is left with the connected slots" ) {
+				std::size_t connected = 0;
+				for( auto const& c : connections ) {
+					connected += c.connected() ? 1 : 0;
+				}
+				REQUIRE( signal.slot_count() == connected );
+				sum = 0;
+				signal( 1 );
+				REQUIRE( sum == static_cast<long>( connected ) );
+			}
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#include <nod/nod.hpp>
+#include <catch.hpp>
+
+#include <vector>
+
+namespace {
+	std::vector<int> calls;
+
+	int first( int x ) {
+		calls.push_back( 1 );
+		return x + 1;
+	}
+
+	int second( int x ) {
+		calls.push_back( 2 );
+		return x * 2;
+	}
+
+	void notify( int x ) {
+		calls.push_back( x );
+	}
+
+	using signal_type = nod::static_signal<int(int), &first, &second>;
+}
+
+SCENARIO( "Static signals call a fixed set of slots" ) {
+	calls.clear();
+	GIVEN( "a static signal with two slots" ) {
+		signal_type signal;
+		THEN( "the slots are counted at compile time" ) {
+			static_assert( signal_type::slot_count() == 2, "static slot count" );
+			static_assert( !signal_type::empty(), "static signal is not empty" );
+			REQUIRE( signal.slot_count() == 2 );
+		}
+		WHEN( "we trigger the signal" ) {
+			signal( 5 );
+			THEN( "the slots are called in the listed order" ) {
+				REQUIRE( calls == (std::vector<int>{ 1, 2 }) );
+			}
+		}
+		WHEN( "we accumulate the slot return values" ) {
+			auto sum = signal.accumulate( 0, []( int a, int b ) { return a + b; } )( 5 );
+			THEN( "the sum of the return values is returned" ) {
+				REQUIRE( sum == 16 );
+				REQUIRE( calls == (std::vector<int>{ 1, 2 }) );
+			}
+		}
+		WHEN( "we aggregate the slot return values" ) {
+			auto values = signal.aggregate<std::vector<int>>( 5 );
+			THEN( "the return values are collected in order" ) {
+				REQUIRE( values == (std::vector<int>{ 6, 10 }) );
+			}
+		}
+	}
+	GIVEN( "a static signal with a repeated void slot" ) {
+		nod::static_signal<void(int), &notify, &notify, &notify> signal;
+		WHEN( "we trigger the signal" ) {
+			signal( 3 );
+			THEN( "the slot is called for every occurrence" ) {
+				REQUIRE( calls == (std::vector<int>{ 3, 3, 3 }) );
+			}
+		}
+	}
+	GIVEN( "a static signal without slots" ) {
+		nod::static_signal<int(int)> signal;
+		THEN( "triggering it does nothing" ) {
+			static_assert( decltype(signal)::empty(), "static signal is empty" );
+			signal( 1 );
+			REQUIRE( calls.empty() );
+			REQUIRE( signal.aggregate<std::vector<int>>( 1 ).empty() );
+			REQUIRE( signal.accumulate( 7, []( int a, int b ) { return a + b; } )( 1 ) == 7 );
+		}
+	}
+}
@@ -0,0 +1,76 @@
+#include <nod/instrument/statistics.hpp>
+#include <catch.hpp>
+
+#include <thread>
+
+namespace {
+	using statistics_signal = nod::signal_type<nod::statistics_policy<>, int(int)>;
+}
+
+SCENARIO( "Signals with the statistics policy record runtime statistics" ) {
+	GIVEN( "a new signal" ) {
+		statistics_signal signal;
+		THEN( "all statistics are zero" ) {
+			auto stats = signal.stats();
+			REQUIRE( stats.emissions == 0 );
+			REQUIRE( stats.slots_invoked == 0 );
+			REQUIRE( stats.connects == 0 );
+			REQUIRE( stats.disconnects == 0 );
+			REQUIRE( stats.peak_slot_count == 0 );
+			REQUIRE( stats.tombstones == 0 );
+			REQUIRE( stats.emission_time.count() == 0 );
+		}
+		WHEN( "we connect three slots and disconnect the middle one" ) {
+			auto c1 = signal.connect( []( int x ) { return x; } );
+			auto c2 = signal.connect( []( int x ) { return x; } );
+			auto c3 = signal.connect( []( int x ) { return x; } );
+			c2.disconnect();
+			THEN( "the connections and disconnections are counted" ) {
+				auto stats = signal.stats();
+				REQUIRE( stats.connects == 3 );
+				REQUIRE( stats.disconnects == 1 );
+				REQUIRE( stats.peak_slot_count == 3 );
+				REQUIRE( stats.tombstones == 1 );
+			}
+			AND_WHEN( "we trigger the signal in a few different ways" ) {
+				signal( 1 );
+				signal.accumulate( 0, std::plus<int>{} )( 2 );
+				signal.aggregate<std::vector<int>>( 3 );
+				signal.emit_until( []( int ) { return true; } )( 4 );
+				THEN( "the emissions and slot calls are counted" ) {
+					auto stats = signal.stats();
+					REQUIRE( stats.emissions == 4 );
+					REQUIRE( stats.slots_invoked == 7 );
+				}
+			}
+			AND_WHEN( "we disconnect all slots" ) {
+				signal.disconnect_all_slots();
+				THEN( "the remaining slots are counted as disconnected" ) {
+					auto stats = signal.stats();
+					REQUIRE( stats.disconnects == 3 );
+					REQUIRE( stats.tombstones == 0 );
+					REQUIRE( stats.peak_slot_count == 3 );
+				}
+			}
+		}
+		WHEN( "we trigger the signal from several threads" ) {
+			signal.connect( []( int x ) { return x; } );
+			std::vector<std::thread> threads;
+			for( int t = 0; t < 4; ++t ) {
+				threads.emplace_back( [&signal]() {
+						for( int i = 0; i < 1000; ++i ) {
+							signal( i );
+						}
+					});
+			}
+			for( auto& thread : threads ) {
+				thread.join();
+			}
+			THEN( "all emissions from all threads are counted" ) {
+				auto stats = signal.stats();
+				REQUIRE( stats.emissions == 4000 );
+				REQUIRE( stats.slots_invoked == 4000 );
+			}
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#include <nod/instrument/tracing.hpp>
+#include <catch.hpp>
+
+#include <string>
+
+namespace {
+	using traced_signal = nod::signal_type<nod::tracing_policy<>, void()>;
+
+	std::size_t count( std::string const& str, std::string const& pattern ) {
+		std::size_t result = 0;
+		for( auto pos = str.find( pattern ); pos != std::string::npos; pos = str.find( pattern, pos+1 ) ) {
+			++result;
+		}
+		return result;
+	}
+}
+
+SCENARIO( "Signals with the tracing policy record Chrome trace events" ) {
+	nod::tracer::flush_chrome_json();
+	GIVEN( "a named outer signal with a slot that triggers a named inner signal" ) {
+		traced_signal inner{ "inner" };
+		traced_signal outer{ "outer" };
+		inner.connect( [](){} );
+		inner.connect( [](){} );
+		outer.connect( [&inner](){ inner(); } );
+		WHEN( "we trigger the outer signal while the tracer is started" ) {
+			nod::tracer::start();
+			outer();
+			nod::tracer::stop();
+			auto json = nod::tracer::flush_chrome_json();
+			THEN( "begin and end events are recorded for both emissions" ) {
+				REQUIRE( count( json, "\"name\":\"outer\",\"cat\":\"nod.emission\",\"ph\":\"B\"" ) == 1 );
+				REQUIRE( count( json, "\"name\":\"outer\",\"cat\":\"nod.emission\",\"ph\":\"E\"" ) == 1 );
+				REQUIRE( count( json, "\"name\":\"inner\",\"cat\":\"nod.emission\",\"ph\":\"B\"" ) == 1 );
+				REQUIRE( count( json, "\"name\":\"inner\",\"cat\":\"nod.emission\",\"ph\":\"E\"" ) == 1 );
+			}
+			AND_THEN( "begin and end events are recorded for each slot call" ) {
+				REQUIRE( count( json, "\"cat\":\"nod.slot\",\"ph\":\"B\"" ) == 3 );
+				REQUIRE( count( json, "\"cat\":\"nod.slot\",\"ph\":\"E\"" ) == 3 );
+				REQUIRE( count( json, "\"args\":{\"signal\":\"inner\"}" ) == 4 );
+			}
+			AND_THEN( "the inner emission is nested within the outer slot call" ) {
+				auto outer_slot = json.find( "\"name\":\"slot 0\",\"cat\":\"nod.slot\",\"ph\":\"B\"" );
+				auto inner_begin = json.find( "\"name\":\"inner\",\"cat\":\"nod.emission\",\"ph\":\"B\"" );
+				auto inner_end = json.find( "\"name\":\"inner\",\"cat\":\"nod.emission\",\"ph\":\"E\"" );
+				auto outer_end = json.find( "\"name\":\"outer\",\"cat\":\"nod.emission\",\"ph\":\"E\"" );
+				REQUIRE( outer_slot < inner_begin );
+				REQUIRE( inner_begin < inner_end );
+				REQUIRE( inner_end < outer_end );
+			}
+			AND_THEN( "flushing empties the buffers" ) {
+				auto empty = nod::tracer::flush_chrome_json();
+				REQUIRE( count( empty, "\"ph\"" ) == 0 );
+				REQUIRE( count( empty, "\"dropped_events\":0" ) == 1 );
+			}
+		}
+		WHEN( "we trigger the signal while the tracer is stopped" ) {
+			outer();
+			THEN( "no events are recorded" ) {
+				REQUIRE( count( nod::tracer::flush_chrome_json(), "\"ph\"" ) == 0 );
+			}
+		}
+	}
+	GIVEN( "a unnamed signal" ) {
+		traced_signal signal;
+		signal.connect( [](){} );
+		WHEN( "we trigger the signal while the tracer is started" ) {
+			nod::tracer::start();
+			signal();
+			nod::tracer::stop();
+			THEN( "the emission is recorded with a default name" ) {
+				REQUIRE( count( nod::tracer::flush_chrome_json(), "\"name\":\"nod::signal\"" ) == 2 );
+			}
+		}
+	}
+	GIVEN( "a named signal without the tracing policy" ) {
+		nod::signal<int()> signal{ "untraced" };
+		signal.connect( [](){ return 1; } );
+		THEN( "the name is ignored" ) {
+			REQUIRE( signal.accumulate( 0, std::plus<int>{} )() == 1 );
+		}
+	}
+}
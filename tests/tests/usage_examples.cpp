@@ -122,6 +122,26 @@ SCENARIO( "Example usage") {
 		REQUIRE( signal.accumulate(1, std::multiplies<int>{})(10,100) == -9900000 );
 		REQUIRE( vec == (std::vector<int>{110, 1000, -90}) );
 	}
+	SECTION( "Slot return values (accumulate in place)" ) {
+		// We create a singal with slots that return a value
+		nod::signal<int(int, int)> signal;
+		signal.connect( std::plus<int>{} );
+		signal.connect( std::multiplies<int>{} );
+		signal.connect( std::minus<int>{} );
+		// With accumulate_in_place, the accumulated value is modified through a
+		// reference, and is never copied while the slots are called:
+		auto vec = signal.accumulate_in_place( std::vector<int>{}, []( std::vector<int>& result, int value ) {
+				result.push_back( value );
+			})(10,100);
+
+		std::cout << "Vector: ";
+		for( auto const& element : vec ) {
+			std::cout << element << " ";
+		}
+		std::cout << std::endl;
+
+		REQUIRE( vec == (std::vector<int>{110, 1000, -90}) );
+	}
 	SECTION( "Slot return values (aggregate)" ) {
 		// We create a singal
 		nod::signal<int(int, int)> signal;
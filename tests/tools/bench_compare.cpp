@@ -0,0 +1,409 @@
+// Comparison of nod_bench results.
+//
+// Compares the samples of each benchmark in a baseline and a contender
+// result file with Welch's t-test, and reports the relative change in mean
+// time per operation with its confidence interval. A benchmark has
+// regressed when it is significantly slower, by more than the threshold.
+// The exit status is 2 if any benchmark has regressed.
+
+#include <algorithm>    // std::max
+#include <cctype>       // std::isspace
+#include <cmath>        // std::sqrt, std::log
+#include <cstdlib>      // std::strtod
+#include <cstring>      // std::strncmp
+#include <fstream>      // std::ifstream
+#include <iomanip>      // std::setw
+#include <iostream>     // std::cout, std::cerr
+#include <iterator>     // std::istreambuf_iterator
+#include <sstream>      // std::ostringstream
+#include <stdexcept>    // std::runtime_error
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+namespace {
+
+	/// Options given on the command line
+	struct options
+	{
+		std::vector<std::string> baseline;
+		std::vector<std::string> contender;
+		double threshold = 5.0;
+		double confidence = 95.0;
+	};
+
+	void print_usage( char const* program ) {
+		std::cerr
+			<< "Usage: " << program << " [options] <baseline.json> <contender.json>\n"
+			<< "  Several result files of repeated runs can be given for each side,\n"
+			<< "  separated by commas, and their samples are pooled.\n"
+			<< "  --threshold=<percent>    Smallest slowdown reported as a regression (default 5)\n"
+			<< "  --confidence=<percent>   Confidence level of the intervals (default 95)\n";
+	}
+
+	/// Minimal JSON value, as needed for reading nod_bench results
+	struct json
+	{
+		enum class kind { null, boolean, number, string, array, object };
+		kind type = kind::null;
+		double number = 0.0;
+		std::string string;
+		std::vector<json> array;
+		std::vector<std::pair<std::string, json>> object;
+
+		/// @returns The member with the given name, or a null value
+		json const& operator[]( std::string const& name ) const {
+			static json const null;
+			for( auto const& member : object ) {
+				if( member.first == name ) {
+					return member.second;
+				}
+			}
+			return null;
+		}
+	};
+
+	/// Recursive descent parser of JSON documents
+	class json_parser
+	{
+		public:
+			explicit json_parser( std::string const& text ) :
+				_text( text ),
+				_pos( 0 )
+			{}
+
+			json parse() {
+				json value = parse_value();
+				skip_space();
+				if( _pos != _text.size() ) {
+					fail( "trailing characters" );
+				}
+				return value;
+			}
+
+		private:
+			[[noreturn]] void fail( char const* what ) const {
+				std::ostringstream message;
+				message << "invalid JSON at offset " << _pos << ": " << what;
+				throw std::runtime_error( message.str() );
+			}
+
+			void skip_space() {
+				while( _pos < _text.size() && std::isspace( static_cast<unsigned char>( _text[_pos] ) ) ) {
+					++_pos;
+				}
+			}
+
+			bool consume( char c ) {
+				skip_space();
+				if( _pos < _text.size() && _text[_pos] == c ) {
+					++_pos;
+					return true;
+				}
+				return false;
+			}
+
+			void expect( char c ) {
+				if( !consume( c ) ) {
+					fail( "unexpected character" );
+				}
+			}
+
+			bool consume_word( char const* word ) {
+				auto length = std::strlen( word );
+				if( _text.compare( _pos, length, word ) == 0 ) {
+					_pos += length;
+					return true;
+				}
+				return false;
+			}
+
+			json parse_value() {
+				json value;
+				skip_space();
+				if( _pos == _text.size() ) {
+					fail( "unexpected end" );
+				}
+				char c = _text[_pos];
+				if( c == '{' ) {
+					value.type = json::kind::object;
+					++_pos;
+					if( !consume( '}' ) ) {
+						do {
+							skip_space();
+							auto name = parse_string();
+							expect( ':' );
+							value.object.emplace_back( name, parse_value() );
+						} while( consume( ',' ) );
+						expect( '}' );
+					}
+				}
+				else if( c == '[' ) {
+					value.type = json::kind::array;
+					++_pos;
+					if( !consume( ']' ) ) {
+						do {
+							value.array.push_back( parse_value() );
+						} while( consume( ',' ) );
+						expect( ']' );
+					}
+				}
+				else if( c == '"' ) {
+					value.type = json::kind::string;
+					value.string = parse_string();
+				}
+				else if( consume_word( "true" ) ) {
+					value.type = json::kind::boolean;
+					value.number = 1.0;
+				}
+				else if( consume_word( "false" ) ) {
+					value.type = json::kind::boolean;
+				}
+				else if( consume_word( "null" ) ) {
+					value.type = json::kind::null;
+				}
+				else {
+					char const* begin = _text.c_str() + _pos;
+					char* end = nullptr;
+					value.type = json::kind::number;
+					value.number = std::strtod( begin, &end );
+					if( end == begin ) {
+						fail( "unexpected character" );
+					}
+					_pos += end - begin;
+				}
+				return value;
+			}
+
+			std::string parse_string() {
+				if( _pos >= _text.size() || _text[_pos] != '"' ) {
+					fail( "expected string" );
+				}
+				std::string result;
+				for( ++_pos; _pos < _text.size() && _text[_pos] != '"'; ++_pos ) {
+					if( _text[_pos] == '\\' && ++_pos < _text.size() ) {
+						char c = _text[_pos];
+						result += c == 'n' ? '\n' : c == 't' ? '\t' : c;
+					}
+					else {
+						result += _text[_pos];
+					}
+				}
+				if( _pos == _text.size() ) {
+					fail( "unterminated string" );
+				}
+				++_pos;
+				return result;
+			}
+
+			std::string const& _text;
+			std::size_t _pos;
+	};
+
+	/// Samples of each benchmark, in ns/op, in the order of the files
+	using samples_type = std::vector<std::pair<std::string, std::vector<double>>>;
+
+	/// Read the samples of the benchmarks in result files, pooling the
+	/// samples of benchmarks present in several files.
+	samples_type load( std::vector<std::string> const& paths ) {
+		samples_type result;
+		for( auto const& path : paths ) {
+			std::ifstream file{ path };
+			if( !file ) {
+				throw std::runtime_error( "unable to read " + path );
+			}
+			std::string text{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+			auto document = json_parser{ text }.parse();
+			for( auto const& benchmark : document["benchmarks"].array ) {
+				auto const& name = benchmark["name"].string;
+				auto it = std::find_if( result.begin(), result.end(), [&]( samples_type::value_type const& r ) {
+						return r.first == name;
+					});
+				if( it == result.end() ) {
+					result.emplace_back( name, std::vector<double>{} );
+					it = result.end() - 1;
+				}
+				for( auto const& sample : benchmark["samples"].array ) {
+					it->second.push_back( sample.number );
+				}
+			}
+		}
+		return result;
+	}
+
+	/// Mean and variance of a set of samples
+	struct summary
+	{
+		explicit summary( std::vector<double> const& samples ) :
+			count( static_cast<double>( samples.size() ) ),
+			mean( 0.0 ),
+			variance( 0.0 )
+		{
+			for( auto s : samples ) {
+				mean += s;
+			}
+			mean /= count;
+			for( auto s : samples ) {
+				variance += (s - mean) * (s - mean);
+			}
+			variance = count > 1 ? variance / (count - 1) : 0.0;
+		}
+
+		double count;
+		double mean;
+		double variance;
+	};
+
+	/// @returns The quantile of the standard normal distribution, using
+	///          the rational approximation by Peter Acklam.
+	double normal_quantile( double p ) {
+		static double const a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+		static double const b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01 };
+		static double const c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+		static double const d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00 };
+		if( p < 0.02425 ) {
+			double q = std::sqrt( -2 * std::log( p ) );
+			return (((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5]) / ((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1);
+		}
+		if( p > 1 - 0.02425 ) {
+			return -normal_quantile( 1 - p );
+		}
+		double q = p - 0.5;
+		double r = q * q;
+		return (((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q / (((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1);
+	}
+
+	/// @returns The quantile of Student's t distribution, using the
+	///          Cornish-Fisher expansion around the normal quantile.
+	double t_quantile( double p, double df ) {
+		double z = normal_quantile( p );
+		double z3 = z*z*z, z5 = z3*z*z, z7 = z5*z*z;
+		return z
+			+ (z3 + z) / (4 * df)
+			+ (5*z5 + 16*z3 + 3*z) / (96 * df*df)
+			+ (3*z7 + 19*z5 + 17*z3 - 15*z) / (384 * df*df*df);
+	}
+
+	/// Match a command line argument of the form `--name=value`
+	bool match( char const* arg, char const* name, std::string& value ) {
+		auto length = std::strlen( name );
+		if( std::strncmp( arg, name, length ) == 0 && arg[length] == '=' ) {
+			value = arg + length + 1;
+			return true;
+		}
+		return false;
+	}
+
+	std::vector<std::string> split( std::string const& list ) {
+		std::vector<std::string> result;
+		std::string::size_type begin = 0, end;
+		while( (end = list.find( ',', begin )) != std::string::npos ) {
+			result.push_back( list.substr( begin, end - begin ) );
+			begin = end + 1;
+		}
+		result.push_back( list.substr( begin ) );
+		return result;
+	}
+
+	bool parse( int argc, char** argv, options& opts ) {
+		std::vector<std::string> files;
+		for( int i = 1; i < argc; ++i ) {
+			std::string value;
+			if( match( argv[i], "--threshold", value ) ) {
+				opts.threshold = std::strtod( value.c_str(), nullptr );
+			}
+			else if( match( argv[i], "--confidence", value ) ) {
+				opts.confidence = std::strtod( value.c_str(), nullptr );
+			}
+			else if( argv[i][0] == '-' ) {
+				return false;
+			}
+			else {
+				files.push_back( argv[i] );
+			}
+		}
+		if( files.size() != 2 || opts.confidence <= 0.0 || opts.confidence >= 100.0 ) {
+			return false;
+		}
+		opts.baseline = split( files[0] );
+		opts.contender = split( files[1] );
+		return true;
+	}
+
+	std::string percent( double value ) {
+		std::ostringstream out;
+		out << std::showpos << std::fixed << std::setprecision( 1 ) << value << "%";
+		return out.str();
+	}
+
+}	// anonymous namespace
+
+int main( int argc, char** argv ) {
+	options opts;
+	if( !parse( argc, argv, opts ) ) {
+		print_usage( argv[0] );
+		return 1;
+	}
+	samples_type baseline, contender;
+	try {
+		baseline = load( opts.baseline );
+		contender = load( opts.contender );
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	std::size_t regressions = 0;
+	std::cout << std::left << std::setw(40) << "benchmark" << std::right
+	          << std::setw(14) << "baseline" << std::setw(14) << "contender"
+	          << std::setw(10) << "change" << std::setw(22) << "CI" << "  verdict\n";
+	for( auto const& base : baseline ) {
+		auto it = std::find_if( contender.begin(), contender.end(), [&]( samples_type::value_type const& c ) {
+				return c.first == base.first;
+			});
+		if( it == contender.end() || base.second.empty() || it->second.empty() ) {
+			std::cout << std::left << std::setw(40) << base.first << std::right << "  missing in contender\n";
+			continue;
+		}
+		summary const b{ base.second };
+		summary const c{ it->second };
+		// Welch's t-test on the difference of the means, with the
+		// Welch-Satterthwaite approximation of the degrees of freedom.
+		double const vb = b.variance / b.count;
+		double const vc = c.variance / c.count;
+		double const se = std::sqrt( vb + vc );
+		double const df = (vb + vc) > 0 && b.count > 1 && c.count > 1 ?
+			(vb + vc) * (vb + vc) / (vb*vb / (b.count - 1) + vc*vc / (c.count - 1)) :
+			1.0;
+		double const t = t_quantile( 1.0 - (1.0 - opts.confidence / 100.0) / 2.0, std::max( df, 1.0 ) );
+		double const change = 100.0 * (c.mean - b.mean) / b.mean;
+		double const low = 100.0 * (c.mean - b.mean - t * se) / b.mean;
+		double const high = 100.0 * (c.mean - b.mean + t * se) / b.mean;
+		char const* verdict = "~";
+		if( low > 0.0 && change > opts.threshold ) {
+			verdict = "REGRESSION";
+			++regressions;
+		}
+		else if( high < 0.0 && change < -opts.threshold ) {
+			verdict = "improvement";
+		}
+		else if( low > 0.0 || high < 0.0 ) {
+			verdict = "within threshold";
+		}
+		std::cout << std::left << std::setw(40) << base.first << std::right << std::fixed << std::setprecision(2)
+		          << std::setw(14) << b.mean << std::setw(14) << c.mean
+		          << std::setw(10) << percent( change )
+		          << std::setw(22) << ("[" + percent( low ) + ", " + percent( high ) + "]")
+		          << "  " << verdict << "\n";
+	}
+	for( auto const& c : contender ) {
+		auto it = std::find_if( baseline.begin(), baseline.end(), [&]( samples_type::value_type const& b ) {
+				return b.first == c.first;
+			});
+		if( it == baseline.end() ) {
+			std::cout << std::left << std::setw(40) << c.first << std::right << "  missing in baseline\n";
+		}
+	}
+	std::cout << "\n" << regressions << " regression(s) of more than " << opts.threshold
+	          << "% at " << opts.confidence << "% confidence\n";
+	return regressions > 0 ? 2 : 0;
+}
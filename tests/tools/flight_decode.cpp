@@ -0,0 +1,131 @@
+// Decoder of nod::flight_recorder dumps.
+//
+// Prints the emissions of a dump as text, ordered by their start time,
+// or as CSV with the --csv option.
+
+#include <algorithm>    // std::sort
+#include <cstdint>      // std::uint32_t, std::int64_t
+#include <cstring>      // std::strcmp
+#include <fstream>      // std::ifstream
+#include <iomanip>      // std::setw
+#include <iostream>     // std::cout, std::cerr
+#include <map>          // std::map
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+namespace {
+
+	/// A emission as stored in a dump
+	struct emission
+	{
+		std::uint32_t thread_id;
+		std::uint32_t signal_id;
+		std::uint32_t slot_count;
+		std::int64_t timestamp;
+		std::int64_t duration;
+	};
+
+	/// Contents of a dump
+	struct dump
+	{
+		std::int64_t steady_time;
+		std::int64_t system_time;
+		std::map<std::uint32_t, std::string> names;
+		std::vector<emission> emissions;
+	};
+
+	/// Read a integer in host byte order
+	template <class T>
+	bool read( std::istream& in, T& value ) {
+		return static_cast<bool>( in.read( reinterpret_cast<char*>( &value ), sizeof(T) ) );
+	}
+
+	bool load( std::istream& in, dump& result ) {
+		char magic[8];
+		std::uint32_t version;
+		if( !in.read( magic, sizeof(magic) ) || std::string( magic, sizeof(magic) ) != "NODFLREC" ) {
+			std::cerr << "Not a nod flight recorder dump" << std::endl;
+			return false;
+		}
+		if( !read( in, version ) || version != 1 ) {
+			std::cerr << "Unsupported dump format version " << version << std::endl;
+			return false;
+		}
+		std::uint32_t name_count;
+		if( !read( in, result.steady_time ) || !read( in, result.system_time ) || !read( in, name_count ) ) {
+			return false;
+		}
+		for( std::uint32_t i = 0; i < name_count; ++i ) {
+			std::uint32_t id, length;
+			if( !read( in, id ) || !read( in, length ) ) {
+				return false;
+			}
+			std::string name( length, '\0' );
+			if( !in.read( &name[0], length ) ) {
+				return false;
+			}
+			result.names[id] = name;
+		}
+		std::uint32_t thread_count;
+		if( !read( in, thread_count ) ) {
+			return false;
+		}
+		for( std::uint32_t t = 0; t < thread_count; ++t ) {
+			std::uint32_t thread_id, count;
+			if( !read( in, thread_id ) || !read( in, count ) ) {
+				return false;
+			}
+			for( std::uint32_t i = 0; i < count; ++i ) {
+				emission e;
+				e.thread_id = thread_id;
+				if( !read( in, e.signal_id ) || !read( in, e.slot_count ) || !read( in, e.timestamp ) || !read( in, e.duration ) ) {
+					return false;
+				}
+				result.emissions.push_back( e );
+			}
+		}
+		return true;
+	}
+
+	std::string signal_name( dump const& d, std::uint32_t id ) {
+		auto it = d.names.find( id );
+		return it != d.names.end() ? it->second : "#" + std::to_string( id );
+	}
+}
+
+int main( int argc, char** argv ) {
+	bool csv = argc == 3 && std::strcmp( argv[2], "--csv" ) == 0;
+	if( argc != 2 && !csv ) {
+		std::cerr << "Usage: " << argv[0] << " <dump file> [--csv]" << std::endl;
+		return 1;
+	}
+	std::ifstream in{ argv[1], std::ios::binary };
+	dump d;
+	if( !in || !load( in, d ) ) {
+		std::cerr << "Failed to read " << argv[1] << std::endl;
+		return 1;
+	}
+	std::sort( d.emissions.begin(), d.emissions.end(), []( emission const& a, emission const& b ) {
+			return a.timestamp < b.timestamp;
+		});
+	if( csv ) {
+		std::cout << "system_time_ns,thread,signal_id,signal,slots,duration_ns\n";
+	}
+	for( auto const& e : d.emissions ) {
+		// Convert the steady clock start time to system clock time, using
+		// the times of the dump as reference.
+		auto system_time = d.system_time - ( d.steady_time - e.timestamp );
+		if( csv ) {
+			std::cout << system_time << "," << e.thread_id << "," << e.signal_id << ","
+			          << signal_name( d, e.signal_id ) << "," << e.slot_count << "," << e.duration << "\n";
+		}
+		else {
+			std::cout << std::setw(16) << ( e.timestamp - d.steady_time ) << " ns"
+			          << "  thread " << std::setw(3) << e.thread_id
+			          << "  " << std::setw(24) << std::left << signal_name( d, e.signal_id ) << std::right
+			          << "  slots " << std::setw(5) << e.slot_count
+			          << "  " << std::setw(10) << e.duration << " ns\n";
+		}
+	}
+	return 0;
+}